@@ -0,0 +1,141 @@
+// Compares sprite vertex generation strategies:
+//  - glm:    the former renderQuad() path (translate/rotate/translate/scale mat4 per sprite)
+//  - scalar: 2D affine transform, one sprite at a time
+//  - simd:   buildSpriteVertices() with the compiled instruction set
+//
+// Usage: sprite_kernel_benchmark [sprites] [iterations]
+
+#include "retronomicon/graphics/renderer/opengl_sprite_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace retronomicon::opengl::graphics::renderer;
+
+namespace {
+
+struct SpriteData {
+    std::vector<float> x, y, width, height, anchorX, anchorY, rotation, u0, v0, u1, v1;
+    std::vector<uint32_t> color;
+
+    explicit SpriteData(std::size_t count) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> pos(0.0f, 1920.0f);
+        std::uniform_real_distribution<float> size(8.0f, 64.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+
+        for (auto* v : { &x, &y, &width, &height, &anchorX, &anchorY, &rotation, &u0, &v0, &u1, &v1 })
+            v->resize(count);
+        color.resize(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            x[i] = pos(rng);
+            y[i] = pos(rng);
+            width[i] = size(rng);
+            height[i] = size(rng);
+            anchorX[i] = 0.5f;
+            anchorY[i] = 0.5f;
+            rotation[i] = angle(rng);
+            u0[i] = unit(rng) * 0.5f;
+            v0[i] = unit(rng) * 0.5f;
+            u1[i] = u0[i] + 0.25f;
+            v1[i] = v0[i] + 0.25f;
+            color[i] = 0xFFFFFFFFu;
+        }
+    }
+
+    SpriteArrays view() const {
+        SpriteArrays s;
+        s.x = x.data(); s.y = y.data();
+        s.width = width.data(); s.height = height.data();
+        s.anchorX = anchorX.data(); s.anchorY = anchorY.data();
+        s.rotation = rotation.data();
+        s.u0 = u0.data(); s.v0 = v0.data(); s.u1 = u1.data(); s.v1 = v1.data();
+        s.color = color.data();
+        return s;
+    }
+};
+
+// Mirrors the transform previously built per quad in OpenGLRenderer::renderQuad()
+void buildWithGlm(const SpriteData& d, std::size_t count, SpriteVertex* out) {
+    static const glm::vec4 corners[4] = {
+        { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f },
+        { 1.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 1.0f },
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        glm::mat4 transform(1.0f);
+        transform = glm::translate(transform, glm::vec3(d.x[i], d.y[i], 0.0f));
+        transform = glm::rotate(transform, glm::radians(d.rotation[i]), glm::vec3(0, 0, 1));
+        transform = glm::translate(transform, glm::vec3(-d.width[i] * d.anchorX[i],
+                                                        -d.height[i] * d.anchorY[i], 0.0f));
+        transform = glm::scale(transform, glm::vec3(d.width[i], d.height[i], 1.0f));
+
+        for (int k = 0; k < 4; ++k) {
+            glm::vec4 p = transform * corners[k];
+            SpriteVertex& v = out[i * 4 + k];
+            v.x = p.x;
+            v.y = p.y;
+            v.u = corners[k].x ? d.u1[i] : d.u0[i];
+            v.v = corners[k].y ? d.v1[i] : d.v0[i];
+            v.r = v.g = v.b = v.a = 255;
+        }
+    }
+}
+
+template <typename Fn>
+double measure(const char* label, std::size_t count, int iterations, Fn&& fn) {
+    fn(); // warm-up
+
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it)
+        fn();
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double perSprite = ns / (double(count) * iterations);
+    std::printf("  %-8s %8.2f ns/sprite  %8.3f ms/frame\n", label, perSprite, perSprite * count / 1e6);
+    return perSprite;
+}
+
+float maxPositionError(const std::vector<SpriteVertex>& a, const std::vector<SpriteVertex>& b) {
+    float err = 0.0f;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        err = std::max(err, std::fabs(a[i].x - b[i].x));
+        err = std::max(err, std::fabs(a[i].y - b[i].y));
+    }
+    return err;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    int iterations    = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    SpriteData data(count);
+    SpriteArrays arrays = data.view();
+
+    std::vector<SpriteVertex> glmOut(count * 4), scalarOut(count * 4), simdOut(count * 4);
+
+    std::printf("Sprite vertex generation: %zu sprites x %d iterations (SIMD: %s)\n",
+                count, iterations, getSpriteKernelIsa());
+
+    double glmNs    = measure("glm", count, iterations, [&] { buildWithGlm(data, count, glmOut.data()); });
+    double scalarNs = measure("scalar", count, iterations, [&] { buildSpriteVerticesScalar(arrays, count, scalarOut.data()); });
+    double simdNs   = measure("simd", count, iterations, [&] { buildSpriteVertices(arrays, count, simdOut.data()); });
+
+    std::printf("  speedup vs glm: scalar %.2fx, simd %.2fx\n", glmNs / scalarNs, glmNs / simdNs);
+    std::printf("  max |simd - glm| = %g px\n", maxPositionError(simdOut, glmOut));
+
+    return 0;
+}
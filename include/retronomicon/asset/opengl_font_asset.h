@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
 
 #include "retronomicon/asset/font_asset.h"
 
+struct stbtt_fontinfo;
+
 namespace retronomicon::opengl::asset {
     struct GlyphBitmap {
         int width;
@@ -17,10 +20,21 @@ namespace retronomicon::opengl::asset {
      *
      * This class extends the backend-agnostic `FontAsset` by:
      *  - rasterizing glyphs (via FreeType or equivalent),
-     *  - packing glyph bitmaps into a single RGBA texture atlas,
+     *  - packing glyph bitmaps into a single one-channel texture atlas,
      *  - computing glyph metrics and atlas coordinates,
      *  - exposing raw atlas pixels for OpenGL texture upload.
      *
+     * In distance field mode (setDistanceField()) the atlas alpha holds a
+     * signed distance to the glyph outline instead of coverage: 128 on
+     * the edge, rising inside and falling outside over getDistanceSpread()
+     * pixels. Such an atlas stays sharp at any scale when drawn with the
+     * renderer's distance field shader, so one small atlas per typeface
+     * serves every text size.
+     *
+     * load() bakes printable ASCII into the atlas. The font file stays
+     * in memory while loaded, so any other codepoint can be rasterized
+     * later with rasterizeGlyph() (see OpenGLGlyphCache).
+     *
      * Ownership model:
      *  - This class owns CPU-side atlas memory (`m_pixels`).
      *  - GPU texture creation is handled externally (e.g. by OpenGLTextureManager).
@@ -55,10 +69,49 @@ namespace retronomicon::opengl::asset {
             unload();
         }
 
+        // stb_truetype state points into m_fontData, so a copy cannot share it
+        OpenGLFontAsset(const OpenGLFontAsset&) = delete;
+        OpenGLFontAsset& operator=(const OpenGLFontAsset&) = delete;
+
         // --------------------------------------------------------
         // Backend loading
         // --------------------------------------------------------
 
+        /**
+         * @brief Rasterize glyphs as signed distance fields instead of coverage.
+         *
+         * Takes effect on the next load(). A point size of 32 to 48 with a
+         * spread of 4 to 8 pixels suits most on-screen sizes.
+         *
+         * @param enabled   Whether to build a distance field atlas.
+         * @param spread    Distance in pixels over which the field falls
+         *                  from the edge to zero; also the border added
+         *                  around each glyph.
+         */
+        void setDistanceField(bool enabled, int spread = 6) {
+            m_distanceField = enabled;
+            m_distanceSpread = spread > 0 ? spread : 1;
+        }
+
+        /**
+         * @brief Check whether the atlas holds distance fields.
+         */
+        bool isDistanceField() const noexcept { return m_distanceField; }
+
+        /**
+         * @brief Get the distance field spread in atlas pixels.
+         */
+        int getDistanceSpread() const noexcept { return m_distanceSpread; }
+
+        /**
+         * @brief Choose whether the atlas is rounded to power-of-two sides.
+         *
+         * Takes effect on the next load(). With false, the atlas is sized
+         * to the packed glyphs (sides rounded to multiples of 4), which
+         * saves memory wherever non-power-of-two textures are supported.
+         */
+        void setPowerOfTwoAtlas(bool enabled) noexcept { m_powerOfTwoAtlas = enabled; }
+
         /**
          * @brief Load and rasterize font glyphs, then build texture atlas.
          *
@@ -81,9 +134,11 @@ namespace retronomicon::opengl::asset {
         // --------------------------------------------------------
 
         /**
-         * @brief Get raw RGBA atlas pixels.
+         * @brief Get raw atlas pixels, one byte per texel.
          *
-         * These pixels are intended to be uploaded to a GPU texture.
+         * Each byte is glyph coverage (or distance). These pixels are
+         * intended to be uploaded as a TextureFormat::Alpha8 texture,
+         * which samples as white with the byte in alpha.
          */
         const std::vector<uint8_t>& getAtlasPixels() const noexcept { return m_pixels; }
 
@@ -97,6 +152,62 @@ namespace retronomicon::opengl::asset {
          */
         int getAtlasHeight() const noexcept { return m_atlasHeight; }
 
+        /**
+         * @brief Get the fraction of the atlas covered by glyph pixels.
+         *
+         * @return Efficiency in [0, 1]; the rest is padding and free space.
+         */
+        float getPackingEfficiency() const noexcept { return m_packingEfficiency; }
+
+        /**
+         * @brief Get the metrics of a glyph.
+         *
+         * @return Metrics, or nullptr if the character was not rasterized.
+         */
+        const GlyphMetrics* getGlyph(char c) const {
+            auto it = m_glyphs.find(c);
+            return it != m_glyphs.end() ? &it->second : nullptr;
+        }
+
+        /**
+         * @brief Rasterize any codepoint of the loaded font.
+         *
+         * Uses the same size and distance field settings as the atlas.
+         * Codepoints missing from the font give the font's fallback glyph.
+         * Atlas fields of @p metrics are left at zero.
+         *
+         * @param codepoint Unicode codepoint.
+         * @param bitmap    Receives the single-channel glyph image (empty for blank glyphs).
+         * @param metrics   Receives size, bearing and advance in pixels.
+         * @return false if the font is not loaded.
+         */
+        bool rasterizeGlyph(uint32_t codepoint, GlyphBitmap& bitmap, GlyphMetrics& metrics) const;
+
+        /**
+         * @brief Check whether the font has an outline for a codepoint.
+         */
+        bool hasGlyph(uint32_t codepoint) const;
+
+        /**
+         * @brief Get the distance from the top of a line to the baseline, in pixels.
+         */
+        int getAscent() const noexcept { return m_ascent; }
+
+        /**
+         * @brief Get the distance from the baseline to the bottom of a line (negative), in pixels.
+         */
+        int getDescent() const noexcept { return m_descent; }
+
+        /**
+         * @brief Get the extra spacing between two lines, in pixels.
+         */
+        int getLineGap() const noexcept { return m_lineGap; }
+
+        /**
+         * @brief Get the distance between two baselines, in pixels.
+         */
+        int getLineHeight() const noexcept { return m_ascent - m_descent + m_lineGap; }
+
         /**
          * @brief Debug string describing this font asset.
          */
@@ -108,11 +219,33 @@ namespace retronomicon::opengl::asset {
         // --------------------------------------------------------
         // Atlas data (CPU-side)
         // --------------------------------------------------------
-        std::vector<uint8_t> m_pixels; ///< RGBA atlas pixel buffer.
-        int m_atlasWidth  = 0;         ///< Atlas width in pixels.
-        int m_atlasHeight = 0;         ///< Atlas height in pixels.
+        std::vector<uint8_t> m_pixels;    ///< Single-channel atlas pixel buffer.
+        int m_atlasWidth  = 0;            ///< Atlas width in pixels.
+        int m_atlasHeight = 0;            ///< Atlas height in pixels.
+        float m_packingEfficiency = 0.0f; ///< Glyph pixels / atlas pixels.
+        bool m_powerOfTwoAtlas = true;    ///< Round atlas sides to powers of two.
         std::unordered_map<char, GlyphBitmap> m_bitmaps;
 
+        // --------------------------------------------------------
+        // Font file, kept for on-demand rasterization
+        // --------------------------------------------------------
+        std::vector<uint8_t> m_fontData;
+        std::shared_ptr<stbtt_fontinfo> m_fontInfo;
+        float m_scale = 0.0f;
+
+        // --------------------------------------------------------
+        // Distance field mode
+        // --------------------------------------------------------
+        bool m_distanceField = false;
+        int m_distanceSpread = 6;
+
+        // --------------------------------------------------------
+        // Vertical metrics, scaled to pixels
+        // --------------------------------------------------------
+        int m_ascent  = 0;
+        int m_descent = 0;
+        int m_lineGap = 0;
+
         // --------------------------------------------------------
         // Internal loading steps
         // --------------------------------------------------------
@@ -129,6 +262,9 @@ namespace retronomicon::opengl::asset {
         /**
          * @brief Pack glyph bitmaps into a single atlas image.
          *
+         * Glyphs are sorted by height and placed with a SkylinePacker in
+         * the smallest atlas they fit in.
+         *
          * Fills:
          *  - `m_pixels`
          *  - atlas coordinates in `FontAsset::GlyphMetrics`
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @enum CompressedFormat
+     * @brief Pixel formats a texture can be stored in on disk and on the GPU.
+     *
+     * All block formats work on 4x4 texel blocks; images whose size is
+     * not a multiple of 4 are padded to whole blocks.
+     */
+    enum class CompressedFormat : uint8_t {
+        /** Uncompressed 8-bit RGBA */
+        RGBA8,
+
+        /** BC1 / DXT1 opaque RGB, 8 bytes per block */
+        BC1,
+
+        /** BC3 / DXT5 RGBA, 16 bytes per block */
+        BC3,
+
+        /** BC7 RGBA, 16 bytes per block */
+        BC7,
+
+        /** ETC2 RGB, 8 bytes per block */
+        ETC2_RGB,
+
+        /** ETC2 RGBA with EAC alpha, 16 bytes per block */
+        ETC2_RGBA
+    };
+
+    /**
+     * @brief Gets the short lowercase name of a format ("bc7", "etc2a", ...).
+     *
+     * Used for file suffixes and command line options.
+     */
+    const char* getFormatName(CompressedFormat format) noexcept;
+
+    /**
+     * @brief Parses a name returned by getFormatName().
+     *
+     * @return false if the name is unknown.
+     */
+    bool parseFormatName(const char* name, CompressedFormat& out) noexcept;
+
+    /**
+     * @brief Checks whether a format is a 4x4 block format.
+     */
+    inline bool isBlockFormat(CompressedFormat format) noexcept { return format != CompressedFormat::RGBA8; }
+
+    /**
+     * @brief Checks whether a format stores alpha.
+     */
+    bool hasAlpha(CompressedFormat format) noexcept;
+
+    /**
+     * @brief Gets the bytes per 4x4 block (per texel for RGBA8).
+     */
+    std::size_t getBlockBytes(CompressedFormat format) noexcept;
+
+    /**
+     * @brief Gets the storage size of one image in a format.
+     */
+    std::size_t getImageSize(CompressedFormat format, int width, int height) noexcept;
+
+    /**
+     * @brief Decodes an image to tightly packed RGBA8.
+     *
+     * Used when the GPU cannot sample a format directly.
+     *
+     * @param format Format of @p src.
+     * @param src getImageSize(format, width, height) bytes.
+     * @param width Image width.
+     * @param height Image height.
+     * @param rgba Receives width * height * 4 bytes.
+     */
+    void decodeImage(CompressedFormat format, const uint8_t* src, int width, int height, uint8_t* rgba);
+
+    /**
+     * @brief Encodes tightly packed RGBA8 pixels into a format.
+     *
+     * A fast single-pass encoder meant for offline conversion: BC1/BC3 fit
+     * endpoints along the principal axis, BC7 uses mode 6, ETC2 RGB uses
+     * the ETC1-compatible modes and EAC alpha searches all tables.
+     *
+     * @param format Target format.
+     * @param rgba width * height * 4 bytes.
+     * @param width Image width.
+     * @param height Image height.
+     * @param dst Receives getImageSize(format, width, height) bytes.
+     */
+    void encodeImage(CompressedFormat format, const uint8_t* rgba, int width, int height, uint8_t* dst);
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "retronomicon/graphics/skyline_packer.h"
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @class DirtyRegion
+     * @brief Collects the changed rectangles of an image between two uploads.
+     *
+     * Rectangles are clipped to the image and merged as they are added:
+     * two rectangles become their bounding box whenever that box is no
+     * larger than the two areas combined, so overlapping and adjacent
+     * edits collapse into one upload. When more than getMaxRects()
+     * rectangles remain, the pair whose bounding box wastes the fewest
+     * pixels is merged, which bounds the number of glTexSubImage2D calls
+     * per flush.
+     *
+     * The region owns no pixels; see OpenGLTexture::update().
+     */
+    class DirtyRegion {
+    public:
+        /**
+         * @brief Constructs an empty region.
+         *
+         * @param width Image width rectangles are clipped to.
+         * @param height Image height rectangles are clipped to.
+         * @param maxRects Maximum rectangles kept (at least 1).
+         */
+        DirtyRegion(int width = 0, int height = 0, std::size_t maxRects = 8);
+
+        /**
+         * @brief Empties the region, optionally changing the image size.
+         */
+        void reset(int width, int height);
+
+        /**
+         * @brief Marks a rectangle as changed.
+         *
+         * Empty rectangles and those entirely outside the image are ignored.
+         */
+        void add(int x, int y, int width, int height);
+
+        /**
+         * @brief Marks the whole image as changed.
+         */
+        void addAll() { add(0, 0, m_width, m_height); }
+
+        /**
+         * @brief Forgets all rectangles; call after uploading them.
+         */
+        void clear() noexcept { m_rects.clear(); }
+
+        /**
+         * @brief Checks whether nothing changed.
+         */
+        bool empty() const noexcept { return m_rects.empty(); }
+
+        /**
+         * @brief Gets the coalesced rectangles.
+         */
+        const std::vector<PackedRect>& getRects() const noexcept { return m_rects; }
+
+        /**
+         * @brief Gets the number of pixels covered by the rectangles.
+         */
+        std::size_t getArea() const noexcept;
+
+        /**
+         * @brief Gets the maximum number of rectangles kept.
+         */
+        std::size_t getMaxRects() const noexcept { return m_maxRects; }
+
+        /**
+         * @brief Gets the image width.
+         */
+        int getWidth() const noexcept { return m_width; }
+
+        /**
+         * @brief Gets the image height.
+         */
+        int getHeight() const noexcept { return m_height; }
+
+    private:
+        /**
+         * @brief Merges the rectangle at @p index with every rectangle it cheaply combines with.
+         */
+        void absorb(std::size_t index);
+
+        /**
+         * @brief Merges the cheapest pair until at most m_maxRects rectangles remain.
+         */
+        void reduce();
+
+        int m_width;
+        int m_height;
+        std::size_t m_maxRects;
+        std::vector<PackedRect> m_rects;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "retronomicon/graphics/block_compression.h"
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @struct Ktx2Image
+     * @brief A 2D texture with its mip chain, as stored in a KTX2 file.
+     *
+     * Only the subset used by the engine is supported: a single 2D image
+     * (no arrays, cube maps or depth), in one of the CompressedFormat
+     * formats, without supercompression.
+     */
+    struct Ktx2Image {
+        CompressedFormat format = CompressedFormat::RGBA8;
+
+        /** Size of mip level 0 in pixels */
+        int width = 0;
+        int height = 0;
+
+        /** Level data, largest first; level i is getImageSize() of (width >> i, height >> i) */
+        std::vector<std::vector<uint8_t>> levels;
+    };
+
+    /**
+     * @brief Gets the size of a mip level (never below 1).
+     */
+    inline int getMipSize(int size, int level) noexcept { return (size >> level) > 0 ? (size >> level) : 1; }
+
+    /**
+     * @brief Parses a KTX2 file held in memory.
+     *
+     * @throws std::runtime_error if the data is not a supported KTX2 texture.
+     */
+    Ktx2Image parseKtx2(const uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Reads a KTX2 file.
+     *
+     * @throws std::runtime_error if the file cannot be read or is not supported.
+     */
+    Ktx2Image loadKtx2(const std::string& path);
+
+    /**
+     * @brief Writes a KTX2 file, including its data format descriptor.
+     *
+     * @throws std::runtime_error if the image is inconsistent or the file cannot be written.
+     */
+    void saveKtx2(const std::string& path, const Ktx2Image& image);
+
+} // namespace retronomicon::opengl::graphics
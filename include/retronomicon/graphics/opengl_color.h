@@ -1,4 +1,6 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include "retronomicon/graphics/color.h"
 
 namespace retronomicon::opengl::graphics {
@@ -64,6 +66,27 @@ namespace retronomicon::opengl::graphics {
             out[2] = m_b;
             out[3] = m_a;
         }
+
+        /**
+         * @brief Converts a color and alpha multiplier into clamped RGBA8.
+         *
+         * Used to fill packed vertex colors.
+         *
+         * @param color Source color.
+         * @param alpha Multiplier applied to the alpha component.
+         * @param out Array of four bytes receiving RGBA values.
+         */
+        static void packRGBA8(const retronomicon::graphics::Color& color,
+                              float alpha,
+                              uint8_t out[4]) noexcept {
+            auto toByte = [](float c) {
+                return static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+            };
+            out[0] = toByte(color.r());
+            out[1] = toByte(color.g());
+            out[2] = toByte(color.b());
+            out[3] = toByte(color.a() * alpha);
+        }
     };
 
 } // namespace retronomicon::opengl::graphics
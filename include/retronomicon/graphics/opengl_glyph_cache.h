@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "retronomicon/asset/opengl_font_asset.h"
+#include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/skyline_packer.h"
+
+namespace retronomicon::opengl::graphics {
+
+    using retronomicon::opengl::asset::OpenGLFontAsset;
+    using retronomicon::opengl::asset::GlyphBitmap;
+
+    /**
+     * @class OpenGLGlyphCache
+     * @brief Glyph atlas filled on demand, keyed by Unicode codepoint.
+     *
+     * A glyph is rasterized by the font the first time it is requested,
+     * packed into a page with a SkylinePacker and uploaded as one small
+     * sub-rectangle; nothing else of the page is touched. Localized text
+     * only pays for the characters it actually shows.
+     *
+     * When no page has room and the page limit is reached, the least
+     * recently used page is emptied and its glyphs are dropped; they are
+     * rasterized again if they come back. Pages used in the current frame
+     * are never evicted, because quads already batched still sample them.
+     * Call nextFrame() once per frame so older pages become evictable.
+     *
+     * Pages sample like the font's own atlas (white, coverage or distance
+     * in alpha): one byte per texel swizzled on sampling, or RGBA where
+     * texture swizzles are unsupported.
+     *
+     * All methods must run on the thread owning the GL context.
+     */
+    class OpenGLGlyphCache {
+    public:
+        /**
+         * @struct Glyph
+         * @brief A cached glyph and where it lives.
+         */
+        struct Glyph {
+            /** Size, bearing, advance and UVs within the page */
+            OpenGLFontAsset::GlyphMetrics metrics;
+
+            /** Index of the page holding the pixels (see getPage()) */
+            uint16_t page = 0;
+        };
+
+        /**
+         * @brief Creates an empty cache for a loaded font.
+         *
+         * @param font Font glyphs are rasterized from.
+         * @param pageSize Width and height of each page in pixels.
+         * @param maxPages Pages allocated before eviction starts.
+         */
+        explicit OpenGLGlyphCache(std::shared_ptr<OpenGLFontAsset> font,
+                                  int pageSize = 1024,
+                                  std::size_t maxPages = 4);
+
+        OpenGLGlyphCache(const OpenGLGlyphCache&) = delete;
+        OpenGLGlyphCache& operator=(const OpenGLGlyphCache&) = delete;
+
+        /**
+         * @brief Gets a glyph, rasterizing and uploading it on first use.
+         *
+         * The pointer stays valid until the glyph's page is evicted, which
+         * cannot happen before the next nextFrame().
+         *
+         * @param codepoint Unicode codepoint.
+         * @return Glyph, or nullptr if it is larger than a page or every
+         *         page is full and in use this frame.
+         */
+        const Glyph* getGlyph(uint32_t codepoint);
+
+        /**
+         * @brief Rasterizes and uploads glyphs ahead of time (e.g. a loading screen).
+         *
+         * @return Number of codepoints now cached.
+         */
+        std::size_t preload(const uint32_t* codepoints, std::size_t count);
+
+        /**
+         * @brief Starts a new frame, making pages not used since evictable.
+         */
+        void nextFrame() noexcept { ++m_frame; }
+
+        /**
+         * @brief Drops every glyph and page.
+         */
+        void clear();
+
+        /**
+         * @brief Gets the font glyphs are rasterized from.
+         */
+        const OpenGLFontAsset& getFont() const noexcept { return *m_font; }
+
+        /**
+         * @brief Gets the number of pages allocated.
+         */
+        std::size_t getPageCount() const noexcept { return m_pages.size(); }
+
+        /**
+         * @brief Gets a page texture.
+         */
+        const std::shared_ptr<OpenGLTexture>& getPage(std::size_t index) const { return m_pages[index].texture; }
+
+        /**
+         * @brief Gets the number of glyphs currently cached.
+         */
+        std::size_t getGlyphCount() const noexcept { return m_glyphs.size(); }
+
+        /**
+         * @brief Gets the number of glyphs rasterized since creation.
+         */
+        std::size_t getRasterizedCount() const noexcept { return m_rasterized; }
+
+        /**
+         * @brief Gets the number of page evictions since creation.
+         */
+        std::size_t getEvictionCount() const noexcept { return m_evictions; }
+
+    private:
+        /** A page texture, its free space and the glyphs it holds */
+        struct Page {
+            std::shared_ptr<OpenGLTexture> texture;
+            SkylinePacker packer;
+            std::vector<uint32_t> codepoints;
+            uint64_t lastUsed = 0;
+        };
+
+        /**
+         * @brief Finds room for a padded glyph, creating or evicting a page if needed.
+         *
+         * @return Page index, or -1 if there is no room.
+         */
+        int allocate(int width, int height, PackedRect& out);
+
+        /**
+         * @brief Empties a page and forgets its glyphs.
+         */
+        void evict(std::size_t index);
+
+        /**
+         * @brief Uploads a glyph bitmap with a transparent border.
+         */
+        void upload(const Page& page, const PackedRect& slot, const GlyphBitmap& bitmap);
+
+        std::shared_ptr<OpenGLFontAsset> m_font;
+        int m_pageSize;
+        std::size_t m_maxPages;
+
+        std::vector<Page> m_pages;
+        std::unordered_map<uint32_t, Glyph> m_glyphs;
+
+        /** Bytes per page texel, chosen when the first page is created */
+        int m_channels = 1;
+
+        uint64_t m_frame = 1;
+        std::size_t m_rasterized = 0;
+        std::size_t m_evictions = 0;
+
+        /** Scratch for the glyph being rasterized and its padded block */
+        GlyphBitmap m_bitmap;
+        std::vector<uint8_t> m_scratch;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "retronomicon/graphics/opengl_texture_desc.h"
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @struct SamplerDesc
+     * @brief Sampling state applied to a texture unit independently of the texture.
+     *
+     * Minification always uses the mipmap variant of the filter. Every
+     * texture the library creates (2D textures, atlas and glyph pages,
+     * placeholders, array pools) sets GL_TEXTURE_MAX_LEVEL to its last
+     * level, so single-level textures stay complete and sample level 0.
+     * Textures created outside the library must do the same.
+     */
+    struct SamplerDesc {
+        TextureFilter filter = TextureFilter::Linear;
+        TextureWrap wrap = TextureWrap::ClampToEdge;
+
+        /** Maximum anisotropy (1 = off), clamped to what the driver supports */
+        uint8_t anisotropy = 1;
+
+        /**
+         * @brief Nearest filtering with clamped edges, for pixel art.
+         */
+        static SamplerDesc pixelArt() noexcept {
+            SamplerDesc desc;
+            desc.filter = TextureFilter::Nearest;
+            return desc;
+        }
+
+        /**
+         * @brief Packs the descriptor into a small integer, for cache keys.
+         */
+        uint32_t getKey() const noexcept {
+            return static_cast<uint32_t>(filter)
+                 | (static_cast<uint32_t>(wrap) << 4)
+                 | (static_cast<uint32_t>(anisotropy) << 8);
+        }
+
+        bool operator==(const SamplerDesc& other) const noexcept { return getKey() == other.getKey(); }
+        bool operator!=(const SamplerDesc& other) const noexcept { return getKey() != other.getKey(); }
+    };
+
+    /**
+     * @class OpenGLSamplerCache
+     * @brief Creates one sampler object per distinct SamplerDesc and reuses it.
+     *
+     * A texture bound together with a sampler is sampled with the
+     * sampler's filter and wrap state instead of its own parameters, so a
+     * single upload can be drawn both pixel-perfect and smoothed.
+     * Sampler 0 means "use the texture's parameters".
+     */
+    class OpenGLSamplerCache {
+    public:
+        OpenGLSamplerCache() = default;
+
+        /**
+         * @brief Deletes all sampler objects.
+         */
+        ~OpenGLSamplerCache();
+
+        OpenGLSamplerCache(const OpenGLSamplerCache&) = delete;
+        OpenGLSamplerCache& operator=(const OpenGLSamplerCache&) = delete;
+
+        /**
+         * @brief Checks whether the context supports sampler objects (GL 3.3).
+         *
+         * Requires a loaded OpenGL context.
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Gets the sampler object for a descriptor, creating it on first use.
+         *
+         * Requires a current OpenGL context.
+         *
+         * @return Sampler name, or 0 without sampler object support.
+         */
+        unsigned int get(const SamplerDesc& desc);
+
+        /**
+         * @brief Deletes all sampler objects.
+         *
+         * Names handed out before become invalid.
+         */
+        void release();
+
+        /**
+         * @brief Gets the number of sampler objects created.
+         */
+        std::size_t size() const noexcept { return m_samplers.size(); }
+
+    private:
+        /** SamplerDesc::getKey() -> sampler name */
+        std::unordered_map<uint32_t, unsigned int> m_samplers;
+
+        /** Driver limit for anisotropy, queried on first use (0 = not queried) */
+        float m_maxAnisotropy = 0.0f;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @class OpenGLShaderProgram
+     * @brief Linked GLSL program with reflected uniforms and attributes.
+     *
+     * This class is responsible for:
+     *  - Compiling and linking a vertex/fragment shader pair
+     *  - Reflecting active uniforms and attributes once after linking
+     *  - Setting uniforms through precomputed IDs instead of name lookups
+     *  - Persisting linked programs through an on-disk binary cache
+     *
+     * Uniform IDs are obtained once with findUniform() and are only valid
+     * for the program that produced them.
+     *
+     * The binary cache is keyed by a hash of the shader sources and the
+     * driver identification strings, so a driver update or a source change
+     * transparently falls back to compiling from source.
+     */
+    class OpenGLShaderProgram {
+    public:
+        /** Index into the reflected uniform table, or InvalidId */
+        using UniformId = int;
+
+        /** Returned by findUniform() when the name is not an active uniform */
+        static constexpr UniformId InvalidId = -1;
+
+        /**
+         * @struct Variable
+         * @brief Reflected active uniform or attribute.
+         */
+        struct Variable {
+            /** Name without any trailing "[0]" array suffix */
+            std::string name;
+
+            /** Location used with glUniform* / glVertexAttrib* */
+            int location = -1;
+
+            /** GLSL type (e.g. GL_FLOAT_MAT4) */
+            unsigned int type = 0;
+
+            /** Array size (1 for non-arrays) */
+            int size = 0;
+        };
+
+        /**
+         * @brief Constructs an empty program.
+         */
+        OpenGLShaderProgram() = default;
+
+        /**
+         * @brief Destroys the program and releases the GL object.
+         */
+        ~OpenGLShaderProgram();
+
+        OpenGLShaderProgram(const OpenGLShaderProgram&) = delete;
+        OpenGLShaderProgram& operator=(const OpenGLShaderProgram&) = delete;
+
+        OpenGLShaderProgram(OpenGLShaderProgram&& other) noexcept;
+        OpenGLShaderProgram& operator=(OpenGLShaderProgram&& other) noexcept;
+
+        /**
+         * @brief Sets the directory used to store linked program binaries.
+         *
+         * An empty path (the default) disables the cache. The directory
+         * is created on first write if it does not exist.
+         *
+         * @param directory Cache directory.
+         */
+        static void setBinaryCacheDirectory(const std::string& directory);
+
+        /**
+         * @brief Gets the directory used to store linked program binaries.
+         */
+        static const std::string& getBinaryCacheDirectory();
+
+        /**
+         * @brief Builds the program from GLSL sources.
+         *
+         * Tries the binary cache first; on a miss the sources are compiled,
+         * linked and the result is written back to the cache.
+         *
+         * @param vertexSrc Vertex shader source code.
+         * @param fragmentSrc Fragment shader source code.
+         *
+         * @throws std::runtime_error If compilation or linking fails.
+         */
+        void build(const std::string& vertexSrc, const std::string& fragmentSrc);
+
+        /**
+         * @brief Deletes the GL program and clears reflection data.
+         */
+        void release();
+
+        /**
+         * @brief Makes this program current.
+         */
+        void use() const;
+
+        /**
+         * @brief Gets the OpenGL program object.
+         */
+        unsigned int getId() const noexcept { return m_program; }
+
+        /**
+         * @brief Checks whether the last build() was served from the binary cache.
+         */
+        bool isFromBinaryCache() const noexcept { return m_fromCache; }
+
+        /**
+         * @brief Looks up a uniform ID by name.
+         *
+         * Intended to be called once at setup time; the returned ID is
+         * then used with the set* functions on every frame.
+         *
+         * @param name Uniform name (array uniforms without "[0]").
+         * @return Uniform ID, or InvalidId if the uniform is not active.
+         */
+        UniformId findUniform(const std::string& name) const;
+
+        /**
+         * @brief Gets the location of an active vertex attribute.
+         *
+         * @param name Attribute name.
+         * @return Attribute location, or -1 if the attribute is not active.
+         */
+        int findAttribute(const std::string& name) const;
+
+        /**
+         * @brief Gets all reflected active uniforms.
+         */
+        const std::vector<Variable>& getUniforms() const noexcept { return m_uniforms; }
+
+        /**
+         * @brief Gets all reflected active attributes.
+         */
+        const std::vector<Variable>& getAttributes() const noexcept { return m_attributes; }
+
+        /** @name Uniform setters
+         *  The program must be current. Invalid IDs are ignored.
+         */
+        ///@{
+        void setInt(UniformId id, int value) const;
+        void setIntArray(UniformId id, const int* values, int count) const;
+        void setFloat(UniformId id, float value) const;
+        void setVec2(UniformId id, float x, float y) const;
+        void setVec4(UniformId id, const float* values) const;
+        void setMat4(UniformId id, const float* values) const;
+        ///@}
+
+    private:
+        /**
+         * @brief Compiles and links the program from source.
+         */
+        unsigned int compile(const std::string& vertexSrc, const std::string& fragmentSrc);
+
+        /**
+         * @brief Tries to create the program from a cached binary.
+         *
+         * @return Program ID, or 0 on a miss or if the driver rejects the binary.
+         */
+        unsigned int loadBinary(const std::string& path);
+
+        /**
+         * @brief Writes the linked program binary to the cache.
+         */
+        void storeBinary(const std::string& path) const;
+
+        /**
+         * @brief Fills m_uniforms and m_attributes from the linked program.
+         */
+        void reflect();
+
+        /** OpenGL program object */
+        unsigned int m_program = 0;
+
+        /** Whether the program was created from a cached binary */
+        bool m_fromCache = false;
+
+        /** Reflected active uniforms, indexed by UniformId */
+        std::vector<Variable> m_uniforms;
+
+        /** Reflected active attributes */
+        std::vector<Variable> m_attributes;
+    };
+
+} // namespace retronomicon::opengl::graphics
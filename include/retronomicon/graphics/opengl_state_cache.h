@@ -0,0 +1,235 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @class OpenGLStateCache
+     * @brief Shadows frequently changed OpenGL binding state and skips redundant calls.
+     *
+     * Every bind in the backend goes through this cache, which remembers
+     * the last value sent to the driver and only issues a GL call when the
+     * value actually changes. The following state is tracked:
+     *  - current program
+     *  - active texture unit and the 2D / 2D-array texture bound to each unit
+     *  - sampler object bound to each unit
+     *  - vertex array object
+     *  - non-VAO buffer bindings (array, pixel pack/unpack, copy, uniform)
+     *  - blend enable and blend function
+     *  - viewport
+     *  - pixel unpack alignment
+     *
+     * GL_ELEMENT_ARRAY_BUFFER is part of the VAO state and is therefore
+     * never shadowed; bind it directly while the owning VAO is bound.
+     *
+     * The backend drives a single OpenGL context, so one shared instance
+     * is used (see get()). Code that changes state behind the cache's back
+     * must call invalidate() afterwards.
+     */
+    class OpenGLStateCache {
+    public:
+        /** Number of texture units shadowed; higher units are passed through */
+        static constexpr unsigned int MaxTextureUnits = 32;
+
+        /**
+         * @struct Counters
+         * @brief State change statistics.
+         */
+        struct Counters {
+            /** GL calls actually issued */
+            std::size_t issued = 0;
+
+            /** Calls skipped because the state was already set */
+            std::size_t elided = 0;
+        };
+
+        /**
+         * @brief Gets the cache for the backend's OpenGL context.
+         */
+        static OpenGLStateCache& get();
+
+        /**
+         * @brief Forgets all shadowed state.
+         *
+         * The next call for every piece of state is sent to the driver.
+         * Call after making a context current or after external code
+         * touched GL state.
+         */
+        void invalidate();
+
+        /**
+         * @brief Binds a program object (glUseProgram).
+         */
+        void useProgram(unsigned int program);
+
+        /**
+         * @brief Selects the active texture unit.
+         *
+         * @param unit Zero-based unit index (not GL_TEXTUREi).
+         */
+        void activeTexture(unsigned int unit);
+
+        /**
+         * @brief Binds a texture to the active texture unit.
+         *
+         * @param target GL texture target (e.g. GL_TEXTURE_2D).
+         * @param texture Texture object, or 0 to unbind.
+         */
+        void bindTexture(unsigned int target, unsigned int texture);
+
+        /**
+         * @brief Binds a texture to a specific texture unit.
+         *
+         * Only changes the active unit if the binding is not already in place.
+         *
+         * @param unit Zero-based unit index.
+         * @param target GL texture target.
+         * @param texture Texture object, or 0 to unbind.
+         */
+        void bindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+
+        /**
+         * @brief Binds a vertex array object.
+         */
+        void bindVertexArray(unsigned int vao);
+
+        /**
+         * @brief Binds a sampler object to a texture unit (0 = use the texture's own parameters).
+         *
+         * Does not change the active texture unit.
+         */
+        void bindSampler(unsigned int unit, unsigned int sampler);
+
+        /**
+         * @brief Binds a buffer object to a non-VAO target.
+         *
+         * GL_ELEMENT_ARRAY_BUFFER is forwarded without caching.
+         */
+        void bindBuffer(unsigned int target, unsigned int buffer);
+
+        /**
+         * @brief Enables or disables GL_BLEND.
+         */
+        void setBlend(bool enabled);
+
+        /**
+         * @brief Sets the blend function (glBlendFunc).
+         */
+        void blendFunc(unsigned int srcFactor, unsigned int dstFactor);
+
+        /**
+         * @brief Sets the viewport rectangle.
+         */
+        void viewport(int x, int y, int width, int height);
+
+        /**
+         * @brief Sets GL_UNPACK_ALIGNMENT for pixel uploads.
+         */
+        void unpackAlignment(int alignment);
+
+        /**
+         * @brief Must be called when a texture is deleted.
+         *
+         * Mirrors GL, which unbinds a deleted texture from every unit.
+         */
+        void forgetTexture(unsigned int texture);
+
+        /**
+         * @brief Must be called when a buffer is deleted.
+         */
+        void forgetBuffer(unsigned int buffer);
+
+        /**
+         * @brief Must be called when a vertex array object is deleted.
+         */
+        void forgetVertexArray(unsigned int vao);
+
+        /**
+         * @brief Must be called when a program is deleted.
+         */
+        void forgetProgram(unsigned int program);
+
+        /**
+         * @brief Must be called when a sampler object is deleted.
+         */
+        void forgetSampler(unsigned int sampler);
+
+        /**
+         * @brief Gets the texture currently bound to a unit, or 0 if unknown.
+         */
+        unsigned int getBoundTexture(unsigned int unit, unsigned int target) const;
+
+        /**
+         * @brief Gets the active texture unit index.
+         */
+        unsigned int getActiveTextureUnit() const noexcept { return m_activeUnit; }
+
+        /**
+         * @brief Ends the current frame.
+         *
+         * Moves the running counters into getFrameCounters() and advances
+         * the frame index.
+         */
+        void nextFrame();
+
+        /**
+         * @brief Gets the number of frames ended with nextFrame().
+         *
+         * Safe to call from any thread.
+         */
+        uint64_t getFrameIndex() const noexcept { return m_frameIndex.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the counters of the last completed frame.
+         */
+        const Counters& getFrameCounters() const noexcept { return m_lastFrame; }
+
+        /**
+         * @brief Gets the counters accumulated so far in the current frame.
+         */
+        const Counters& getCurrentCounters() const noexcept { return m_current; }
+
+    private:
+        OpenGLStateCache();
+
+        /** Marker for state whose driver value is unknown */
+        static constexpr unsigned int Unknown = 0xFFFFFFFFu;
+
+        /** Shadowed texture targets per unit */
+        enum TextureSlot { Slot2D = 0, Slot2DArray = 1, SlotCount = 2 };
+
+        /** Shadowed buffer targets */
+        enum BufferSlot { BufArray = 0, BufPixelPack, BufPixelUnpack, BufCopyRead, BufCopyWrite, BufUniform, BufCount };
+
+        static int textureSlot(unsigned int target);
+        static int bufferSlot(unsigned int target);
+
+        bool changed(unsigned int& shadow, unsigned int value);
+
+        unsigned int m_program = Unknown;
+        unsigned int m_activeUnit = Unknown;
+        std::array<std::array<unsigned int, SlotCount>, MaxTextureUnits> m_textures{};
+        std::array<unsigned int, MaxTextureUnits> m_samplers{};
+        unsigned int m_vao = Unknown;
+        std::array<unsigned int, BufCount> m_buffers{};
+
+        /** 0 = disabled, 1 = enabled, Unknown */
+        unsigned int m_blend = Unknown;
+        unsigned int m_blendSrc = Unknown;
+        unsigned int m_blendDst = Unknown;
+
+        std::array<int, 4> m_viewport{};
+        bool m_viewportKnown = false;
+
+        unsigned int m_unpackAlignment = Unknown;
+
+        std::atomic<uint64_t> m_frameIndex{0};
+        Counters m_current;
+        Counters m_lastFrame;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @class OpenGLStreamBuffer
+     * @brief Ring-buffer allocator for geometry uploaded every frame.
+     *
+     * Two strategies are used depending on driver support:
+     *  - Persistent mapping (GL_ARB_buffer_storage): the buffer is mapped
+     *    once with a coherent mapping and the CPU writes straight into it.
+     *    Regions handed to the GPU are tracked with glFenceSync, and an
+     *    allocation only waits if it would overwrite a region the GPU may
+     *    still be reading.
+     *  - Orphaning (plain GL 3.3): allocations are written into a CPU
+     *    staging copy and uploaded with glBufferSubData on commit. When the
+     *    ring wraps, the buffer storage is orphaned with glBufferData so the
+     *    driver never has to synchronize with in-flight draws.
+     *
+     * Usage pattern:
+     *  1. allocate() a worst-case region and write vertices into it.
+     *  2. commit() with the number of bytes actually written.
+     *  3. Issue draw calls sourcing from getBuffer() at the allocation offset.
+     *  4. Call fence() once per frame (e.g. after presenting).
+     */
+    class OpenGLStreamBuffer {
+    public:
+        /**
+         * @struct Allocation
+         * @brief Region of the ring buffer reserved for CPU writes.
+         */
+        struct Allocation {
+            /** CPU-writable pointer to the region */
+            void* data = nullptr;
+
+            /** Byte offset of the region inside the GL buffer */
+            std::size_t offset = 0;
+
+            /** Reserved size in bytes */
+            std::size_t size = 0;
+        };
+
+        /**
+         * @brief Constructs an uninitialized stream buffer.
+         *
+         * @param capacity Ring size in bytes.
+         */
+        explicit OpenGLStreamBuffer(std::size_t capacity = 4 * 1024 * 1024);
+
+        /**
+         * @brief Destroys the buffer, unmapping it and deleting pending fences.
+         */
+        ~OpenGLStreamBuffer();
+
+        OpenGLStreamBuffer(const OpenGLStreamBuffer&) = delete;
+        OpenGLStreamBuffer& operator=(const OpenGLStreamBuffer&) = delete;
+
+        /**
+         * @brief Creates the GL buffer and selects the streaming strategy.
+         *
+         * Requires a current OpenGL context.
+         */
+        void init();
+
+        /**
+         * @brief Releases the GL buffer and all fences.
+         */
+        void shutdown();
+
+        /**
+         * @brief Reserves a region for CPU writes.
+         *
+         * Wraps to the beginning of the ring if the region does not fit
+         * before the end. In persistent mode, blocks until the GPU has
+         * finished reading any fenced region overlapping the allocation.
+         *
+         * @param size Number of bytes to reserve (at most getCapacity()).
+         * @param alignment Offset alignment in bytes (need not be a power of two).
+         * @return The reserved region, or an empty allocation if size is too large.
+         */
+        Allocation allocate(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Publishes the bytes written into an allocation.
+         *
+         * If this is the most recent allocation, any unused tail is
+         * returned to the ring. In orphaning mode the written bytes
+         * are uploaded to the GL buffer.
+         *
+         * @param allocation Allocation returned by allocate().
+         * @param usedBytes Number of bytes written, starting at the allocation offset.
+         */
+        void commit(const Allocation& allocation, std::size_t usedBytes);
+
+        /**
+         * @brief Inserts a fence covering everything committed since the last fence.
+         */
+        void fence();
+
+        /**
+         * @brief Gets the OpenGL buffer object.
+         */
+        unsigned int getBuffer() const noexcept { return m_buffer; }
+
+        /**
+         * @brief Gets the ring size in bytes.
+         */
+        std::size_t getCapacity() const noexcept { return m_capacity; }
+
+        /**
+         * @brief Checks whether the persistent-mapping strategy is in use.
+         */
+        bool isPersistent() const noexcept { return m_mapped != nullptr; }
+
+        /**
+         * @brief Gets how many times an allocation had to wait on a fence.
+         */
+        std::size_t getStallCount() const noexcept { return m_stalls; }
+
+    private:
+        /**
+         * @struct FencedRegion
+         * @brief Byte range the GPU may still be reading.
+         */
+        struct FencedRegion {
+            void* sync;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        /**
+         * @brief Waits for every fenced region overlapping [begin, end).
+         */
+        void waitForRange(std::size_t begin, std::size_t end);
+
+        /** Ring size in bytes */
+        std::size_t m_capacity;
+
+        /** OpenGL buffer object */
+        unsigned int m_buffer = 0;
+
+        /** Persistent mapping (nullptr in orphaning mode) */
+        void* m_mapped = nullptr;
+
+        /** CPU staging copy used in orphaning mode */
+        std::vector<unsigned char> m_staging;
+
+        /** Next free byte */
+        std::size_t m_head = 0;
+
+        /** Start of the region not yet covered by a fence */
+        std::size_t m_fenceStart = 0;
+
+        /** Outstanding fences, oldest first */
+        std::deque<FencedRegion> m_fences;
+
+        /** Number of allocations that blocked on a fence */
+        std::size_t m_stalls = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include "retronomicon/graphics/texture.h"
+#include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/skyline_packer.h"
+
+namespace retronomicon::opengl::graphics {
+
+    using retronomicon::graphics::Texture;
+
+    /**
+     * @class OpenGLSubTexture
+     * @brief Rectangular region of a shared atlas page used as a standalone texture.
+     *
+     * A sub-texture owns no GPU memory; it keeps its page alive and
+     * remembers where its pixels live inside it. Width and height report
+     * the size of the region, so gameplay code can use a sub-texture
+     * anywhere a regular texture is expected. The renderer maps source
+     * rectangles into the page's UV space, which lets sprites from
+     * different images share one batch.
+     */
+    class OpenGLSubTexture : public Texture {
+    public:
+        /**
+         * @brief Creates a sub-texture over a region of a page.
+         *
+         * @param page Atlas page holding the pixels.
+         * @param pageIndex Index of the page in its atlas.
+         * @param rect Pixel rectangle of the region inside the page.
+         */
+        OpenGLSubTexture(std::shared_ptr<OpenGLTexture> page, int pageIndex, const PackedRect& rect);
+
+        /**
+         * @brief Gets the region width in pixels.
+         */
+        int getWidth() const override { return m_rect.width; }
+
+        /**
+         * @brief Gets the region height in pixels.
+         */
+        int getHeight() const override { return m_rect.height; }
+
+        /**
+         * @brief Binds the page texture to the active texture unit.
+         */
+        void bind() const override;
+
+        /**
+         * @brief Unbinds the page texture from the active texture unit.
+         */
+        void unbind() const override;
+
+        /**
+         * @brief Gets the atlas page holding the pixels.
+         */
+        const std::shared_ptr<OpenGLTexture>& getPage() const noexcept { return m_page; }
+
+        /**
+         * @brief Gets the index of the page in its atlas.
+         */
+        int getPageIndex() const noexcept { return m_pageIndex; }
+
+        /**
+         * @brief Gets the pixel rectangle of the region inside the page.
+         */
+        const PackedRect& getRect() const noexcept { return m_rect; }
+
+        /**
+         * @brief Gets the normalized UV rectangle of the region.
+         */
+        float getU0() const noexcept { return m_u0; }
+        float getV0() const noexcept { return m_v0; }
+        float getU1() const noexcept { return m_u1; }
+        float getV1() const noexcept { return m_v1; }
+
+    private:
+        /** Page holding the pixels */
+        std::shared_ptr<OpenGLTexture> m_page;
+
+        /** Index of the page in its atlas */
+        int m_pageIndex;
+
+        /** Region inside the page */
+        PackedRect m_rect;
+
+        /** Normalized UV rectangle */
+        float m_u0, m_v0, m_u1, m_v1;
+    };
+
+} // namespace retronomicon::opengl::graphics
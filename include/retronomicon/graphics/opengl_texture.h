@@ -1,16 +1,24 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include <cstdint>
 #include "retronomicon/graphics/texture.h"
 #include "retronomicon/asset/image_asset.h"
+#include "retronomicon/graphics/dirty_region.h"
+#include "retronomicon/graphics/ktx2_file.h"
+#include "retronomicon/graphics/opengl_stream_buffer.h"
+#include "retronomicon/graphics/opengl_texture_desc.h"
 
 namespace retronomicon::opengl::graphics {
 
     using retronomicon::graphics::Texture;
     using retronomicon::asset::ImageAsset;
 
+    class OpenGLTextureUploader;
+
     /**
      * @class OpenGLTexture
      * @brief OpenGL-backed implementation of the Texture interface.
@@ -24,6 +32,15 @@ namespace retronomicon::opengl::graphics {
      * OpenGLTexture can be constructed from:
      *  - An ImageAsset (asset-driven workflow)
      *  - A raw pixel buffer (procedural or runtime-generated textures)
+     *  - A placeholder, for textures filled in later by an
+     *    OpenGLTextureUploader (asynchronous loading)
+     *  - A Ktx2Image, for block-compressed textures with their mip chain
+     *
+     * Storage, mip chain and sampling follow a TextureDesc. Storage is
+     * immutable (glTexStorage2D) when the driver supports it.
+     *
+     * Uncompressed textures can be partially rewritten with update(),
+     * for glyph caches, minimaps and procedural content.
      *
      * This class is backend-specific and should not be exposed directly
      * to gameplay code.
@@ -34,11 +51,13 @@ namespace retronomicon::opengl::graphics {
          * @brief Creates an OpenGL texture from an ImageAsset.
          *
          * Uploads the image data to the GPU and initializes
-         * the underlying OpenGL texture object.
+         * the underlying OpenGL texture object. The image is kept as the
+         * source the texture is restored from after an eviction.
          *
          * @param image Shared pointer to a loaded ImageAsset.
+         * @param desc Storage, mip and sampling options.
          */
-        OpenGLTexture(std::shared_ptr<ImageAsset> image);
+        OpenGLTexture(std::shared_ptr<ImageAsset> image, const TextureDesc& desc = {});
 
         /**
          * @brief Creates an OpenGL texture from a raw pixel buffer.
@@ -48,17 +67,64 @@ namespace retronomicon::opengl::graphics {
          *  - Framebuffers / render targets
          *  - Procedural textures
          *
-         * The pixel format is inferred from the channel count.
+         * The pixel format is inferred from the channel count unless
+         * @p desc names one.
          *
-         * @param pixels Pointer to raw pixel data.
+         * @param pixels Pointer to raw pixel data, or nullptr to leave the
+         *               storage uninitialized (filled later with glTexSubImage2D).
          * @param width Texture width in pixels.
          * @param height Texture height in pixels.
-         * @param channels Number of color channels (e.g. 3 = RGB, 4 = RGBA).
+         * @param channels Number of color channels (1 = R8, 3 = RGB, 4 = RGBA).
+         * @param desc Storage, mip and sampling options.
          */
         OpenGLTexture(const uint8_t* pixels,
                       int width,
                       int height,
-                      int channels);
+                      int channels,
+                      const TextureDesc& desc = {});
+
+        /**
+         * @brief Creates a texture that is not resident yet.
+         *
+         * Until an OpenGLTextureUploader makes it resident, the texture
+         * draws and reports the size of the placeholder.
+         *
+         * @param placeholder Resident texture shown in the meantime.
+         * @param desc Options applied once the pixels are uploaded.
+         */
+        explicit OpenGLTexture(std::shared_ptr<OpenGLTexture> placeholder, const TextureDesc& desc = {});
+
+        /**
+         * @brief Creates a texture from a KTX2 image and its mip chain.
+         *
+         * Formats the driver samples natively are uploaded as they are;
+         * others are decoded to RGBA8 on the CPU first, level by level.
+         * Compressed textures have no source image and are not evictable.
+         *
+         * MipPolicy::Precomputed (the default) uploads every level of the
+         * file and None only level 0. Generate builds the chain from level 0
+         * on the GPU, except for natively compressed formats, which keep the
+         * file's levels.
+         *
+         * @param image Image with at least one level.
+         * @param desc Mip and sampling options; the format field is ignored.
+         */
+        explicit OpenGLTexture(const Ktx2Image& image, const TextureDesc& desc = TextureDesc::precomputed());
+
+        /**
+         * @brief Checks whether the current context samples a format natively.
+         *
+         * Requires a loaded OpenGL context.
+         */
+        static bool isFormatSupported(CompressedFormat format);
+
+        /**
+         * @brief Checks whether single-channel textures can be swizzled on sampling.
+         *
+         * Without it, TextureFormat::R8 and Alpha8 textures read as red;
+         * callers should upload RGBA instead.
+         */
+        static bool isSwizzleSupported();
 
         /**
          * @brief Destroys the OpenGL texture.
@@ -83,6 +149,8 @@ namespace retronomicon::opengl::graphics {
 
         /**
          * @brief Binds the texture to the active OpenGL texture unit.
+         *
+         * An evicted texture is re-uploaded from its source image first.
          */
         void bind() const override;
 
@@ -91,8 +159,192 @@ namespace retronomicon::opengl::graphics {
          */
         void unbind() const override;
 
+        /**
+         * @brief Gets the underlying OpenGL texture object.
+         *
+         * Used by batching code to compare textures without binding them.
+         *
+         * @return OpenGL texture name (the placeholder's while not resident).
+         */
+        unsigned int getId() const { return m_textureId != 0 ? m_textureId : m_placeholderId; }
+
+        /**
+         * @brief Checks whether the texture's own pixels are on the GPU.
+         */
+        bool isResident() const noexcept { return m_textureId != 0; }
+
+        /**
+         * @brief Gets the format the texture is stored in on the GPU.
+         *
+         * RGBA8 for uncompressed textures and CPU-decoded fallbacks.
+         */
+        CompressedFormat getFormat() const noexcept { return m_format; }
+
+        /**
+         * @brief Gets the storage and sampling options the texture was created with.
+         */
+        const TextureDesc& getDesc() const noexcept { return m_desc; }
+
+        /**
+         * @brief Gets the number of mip levels allocated.
+         */
+        int getMipLevels() const noexcept { return m_mipLevels; }
+
+        /**
+         * @brief Gets the number of channels update() expects per pixel.
+         */
+        int getChannels() const noexcept { return m_channels; }
+
+        // --------------------------------------------------------
+        // Dynamic updates
+        // --------------------------------------------------------
+
+        /**
+         * @brief Rewrites a rectangle of level 0 with glTexSubImage2D.
+         *
+         * Pixels use the texture's channel layout (see getChannels()).
+         * With MipPolicy::Generate the mip chain is rebuilt afterwards;
+         * other levels are left untouched.
+         *
+         * With @p staging, the rows are first copied into the ring buffer
+         * and the texture is filled from it as a pixel unpack buffer, so
+         * the call returns without waiting for the driver to consume the
+         * pixels. The caller must fence() the ring once per frame, as for
+         * geometry. Rectangles larger than the ring are uploaded directly.
+         *
+         * The first update detaches the source image, making the texture
+         * no longer evictable, and marks it modified: OpenGLTextureManager
+         * stops handing it out for the original image, but holders that
+         * already share it see the new pixels. Textures meant to be edited
+         * should be created directly (raw-buffer constructor) or with the
+         * manager's cache disabled. Render thread only.
+         *
+         * @param x Left edge of the rectangle.
+         * @param y Top edge of the rectangle.
+         * @param width Rectangle width.
+         * @param height Rectangle height.
+         * @param pixels First pixel of the rectangle.
+         * @param stride Bytes between rows of @p pixels (0 = width * channels).
+         * @param staging Optional initialized stream buffer used as a PBO.
+         * @return false (with a message) if the texture is compressed, not
+         *         resident, or the rectangle is out of bounds.
+         */
+        bool update(int x, int y, int width, int height,
+                    const uint8_t* pixels, int stride = 0,
+                    OpenGLStreamBuffer* staging = nullptr);
+
+        /**
+         * @brief Uploads every rectangle of a dirty region, then clears it.
+         *
+         * Mips are regenerated once, after all rectangles.
+         *
+         * @param region Changed rectangles; its size must match the texture.
+         * @param pixels Full level 0 image the rectangles are read from.
+         * @param stride Bytes between rows of @p pixels (0 = width * channels).
+         * @param staging Optional stream buffer used as a PBO (see above).
+         * @return false if any rectangle could not be uploaded.
+         */
+        bool update(DirtyRegion& region, const uint8_t* pixels, int stride = 0,
+                    OpenGLStreamBuffer* staging = nullptr);
+
+        // --------------------------------------------------------
+        // Residency (see OpenGLTextureManager::setVramBudget)
+        // --------------------------------------------------------
+
+        /**
+         * @brief Gets the estimated GPU memory of the texture, mip chain included.
+         *
+         * @return Bytes, or 0 when not resident.
+         */
+        std::size_t getByteSize() const noexcept { return m_textureId != 0 ? m_byteSize : 0; }
+
+        /**
+         * @brief Stamps the texture as used in the current frame.
+         *
+         * Called on bind() and whenever a draw references the texture.
+         * Safe to call from any thread.
+         */
+        void touch() const noexcept;
+
+        /**
+         * @brief Gets the frame index (OpenGLStateCache::getFrameIndex) of the last use.
+         */
+        uint64_t getLastUsedFrame() const noexcept { return m_lastUsedFrame.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Checks whether the texture can be evicted and restored from its source image.
+         */
+        bool isEvictable() const noexcept { return m_source != nullptr; }
+
+        /**
+         * @brief Checks whether update() rewrote pixels since creation.
+         */
+        bool isModified() const noexcept { return m_modified; }
+
+        /**
+         * @brief Checks whether the texture was evicted and not restored yet.
+         */
+        bool isEvicted() const noexcept { return m_evicted.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Checks whether a draw recorded off the render thread used the evicted texture.
+         */
+        bool isRestoreRequested() const noexcept { return m_restoreRequested.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Frees the GPU texture, keeping the source image.
+         *
+         * Render thread only.
+         *
+         * @return false if the texture is not evictable or not resident.
+         */
+        bool evict();
+
+        /**
+         * @brief Re-uploads an evicted texture from its source image.
+         *
+         * Render thread only. Does nothing if the texture is not evicted.
+         */
+        void restore();
+
+        /**
+         * @brief Gets the number of times the texture was restored after an eviction.
+         */
+        std::size_t getRestoreCount() const noexcept { return m_restores; }
+
     private:
-        /** OpenGL texture object ID */
+        friend class OpenGLTextureUploader;
+
+        /**
+         * @brief Creates a texture object following @p desc and uploads pixels into it.
+         *
+         * Level 0 is filled when @p pixels is set or @p fromUnpackBuffer is
+         * true; in the latter case @p pixels is an offset into the buffer
+         * bound to GL_PIXEL_UNPACK_BUFFER.
+         *
+         * @return Number of mip levels allocated.
+         */
+        static int upload(unsigned int& id, const uint8_t* pixels, int width, int height, int channels,
+                          const TextureDesc& desc, bool fromUnpackBuffer = false);
+
+        /**
+         * @brief Checks that the texture accepts update() calls.
+         */
+        bool canUpdate() const;
+
+        /**
+         * @brief Uploads one rectangle into the bound texture without touching mips.
+         */
+        void uploadRect(int x, int y, int width, int height,
+                        const uint8_t* pixels, int stride, OpenGLStreamBuffer* staging);
+
+        /**
+         * @brief Takes ownership of an uploaded texture object and drops the placeholder.
+         */
+        void makeResident(unsigned int id, int width, int height, int channels, int mipLevels,
+                          std::shared_ptr<ImageAsset> source);
+
+        /** OpenGL texture object ID (0 while not resident) */
         unsigned int m_textureId;
 
         /** Texture width in pixels */
@@ -100,6 +352,43 @@ namespace retronomicon::opengl::graphics {
 
         /** Texture height in pixels */
         int m_height;
+
+        /** Texture drawn while not resident */
+        std::shared_ptr<OpenGLTexture> m_placeholder;
+
+        /** Cached m_placeholder->getId() */
+        unsigned int m_placeholderId = 0;
+
+        /** Image re-uploaded after an eviction (null if not evictable) */
+        std::shared_ptr<ImageAsset> m_source;
+
+        /** Estimated GPU memory while resident */
+        std::size_t m_byteSize = 0;
+
+        /** Frame of the last touch() */
+        mutable std::atomic<uint64_t> m_lastUsedFrame{0};
+
+        /** Set by touch() while evicted */
+        mutable std::atomic<bool> m_restoreRequested{false};
+
+        /** Written on the render thread, read by touch() on any thread */
+        std::atomic<bool> m_evicted{false};
+
+        /** Set by update(); the pixels no longer match what was created */
+        bool m_modified = false;
+        std::size_t m_restores = 0;
+
+        /** GPU storage format */
+        CompressedFormat m_format = CompressedFormat::RGBA8;
+
+        /** Creation options, reused when restoring after an eviction */
+        TextureDesc m_desc;
+
+        /** Mip levels allocated */
+        int m_mipLevels = 1;
+
+        /** Channels per pixel of the client data the texture was created from */
+        int m_channels = 4;
     };
 
 } // namespace retronomicon::opengl::graphics
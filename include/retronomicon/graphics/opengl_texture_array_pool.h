@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "retronomicon/graphics/texture.h"
+
+namespace retronomicon::opengl::graphics {
+
+    using retronomicon::graphics::Texture;
+
+    class OpenGLTextureArrayPool;
+
+    /**
+     * @class OpenGLArrayTexture
+     * @brief Texture stored as one layer of a pooled GL_TEXTURE_2D_ARRAY.
+     *
+     * The layer is returned to the pool's free-list when the texture is
+     * destroyed. The pool stays alive as long as any of its layers is in use.
+     */
+    class OpenGLArrayTexture : public Texture {
+    public:
+        /**
+         * @brief Wraps a layer acquired from a pool.
+         *
+         * Use OpenGLTextureArrayPool::add() rather than constructing directly.
+         */
+        OpenGLArrayTexture(std::shared_ptr<OpenGLTextureArrayPool> pool, int layer);
+
+        /**
+         * @brief Releases the layer back to the pool.
+         */
+        ~OpenGLArrayTexture();
+
+        OpenGLArrayTexture(const OpenGLArrayTexture&) = delete;
+        OpenGLArrayTexture& operator=(const OpenGLArrayTexture&) = delete;
+
+        /**
+         * @brief Gets the layer width in pixels.
+         */
+        int getWidth() const override;
+
+        /**
+         * @brief Gets the layer height in pixels.
+         */
+        int getHeight() const override;
+
+        /**
+         * @brief Binds the whole array to the active texture unit.
+         */
+        void bind() const override;
+
+        /**
+         * @brief Unbinds the array from the active texture unit.
+         */
+        void unbind() const override;
+
+        /**
+         * @brief Gets the pool owning the layer.
+         */
+        const std::shared_ptr<OpenGLTextureArrayPool>& getPool() const noexcept { return m_pool; }
+
+        /**
+         * @brief Gets the layer index inside the array.
+         */
+        int getLayer() const noexcept { return m_layer; }
+
+    private:
+        std::shared_ptr<OpenGLTextureArrayPool> m_pool;
+        int m_layer;
+    };
+
+    /**
+     * @class OpenGLTextureArrayPool
+     * @brief Stores same-sized, same-format images as layers of one GL_TEXTURE_2D_ARRAY.
+     *
+     * Because every image lives in the same texture object, sprites using
+     * different images of a pool can be drawn in a single batch; the
+     * sprite shader picks the layer per vertex.
+     *
+     * Layers are recycled through a free-list. When no layer is free the
+     * array is reallocated with twice the capacity (up to
+     * GL_MAX_ARRAY_TEXTURE_LAYERS) and existing layers are copied on the
+     * GPU. Growing replaces the GL texture object, so images should be
+     * added at load time, not between recording and drawing a frame.
+     *
+     * Pools must be created with std::make_shared.
+     */
+    class OpenGLTextureArrayPool : public std::enable_shared_from_this<OpenGLTextureArrayPool> {
+    public:
+        /**
+         * @brief Creates an empty pool.
+         *
+         * No GL texture is created until the first image is added.
+         *
+         * @param width Width of every image.
+         * @param height Height of every image.
+         * @param channels Channel count of every image (3 = RGB, 4 = RGBA).
+         * @param initialLayers Capacity of the first allocation.
+         */
+        OpenGLTextureArrayPool(int width, int height, int channels, int initialLayers = 8);
+
+        /**
+         * @brief Deletes the GL texture.
+         */
+        ~OpenGLTextureArrayPool();
+
+        OpenGLTextureArrayPool(const OpenGLTextureArrayPool&) = delete;
+        OpenGLTextureArrayPool& operator=(const OpenGLTextureArrayPool&) = delete;
+
+        /**
+         * @brief Uploads an image into a free layer.
+         *
+         * Requires a current OpenGL context.
+         *
+         * @param pixels Tightly packed pixels matching the pool size and format.
+         * @return Texture for the layer, or nullptr if the pool is at its layer limit.
+         */
+        std::shared_ptr<OpenGLArrayTexture> add(const uint8_t* pixels);
+
+        /**
+         * @brief Gets the OpenGL texture object (changes when the pool grows).
+         */
+        unsigned int getId() const noexcept { return m_textureId; }
+
+        /** @brief Gets the image width. */
+        int getWidth() const noexcept { return m_width; }
+
+        /** @brief Gets the image height. */
+        int getHeight() const noexcept { return m_height; }
+
+        /** @brief Gets the image channel count. */
+        int getChannels() const noexcept { return m_channels; }
+
+        /** @brief Gets the number of allocated layers. */
+        int getCapacity() const noexcept { return m_capacity; }
+
+        /** @brief Gets the number of layers currently in use. */
+        int getUsedLayers() const noexcept { return m_nextLayer - static_cast<int>(m_freeLayers.size()); }
+
+    private:
+        friend class OpenGLArrayTexture;
+
+        /**
+         * @brief Returns a layer to the free-list.
+         */
+        void release(int layer);
+
+        /**
+         * @brief Reallocates the array with a new capacity, keeping existing layers.
+         */
+        bool grow(int capacity);
+
+        int m_width;
+        int m_height;
+        int m_channels;
+        int m_initialLayers;
+
+        unsigned int m_textureId = 0;
+        int m_capacity = 0;
+
+        /** Layers [0, m_nextLayer) have been handed out at least once */
+        int m_nextLayer = 0;
+
+        /** Released layers available for reuse */
+        std::vector<int> m_freeLayers;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "retronomicon/graphics/opengl_sub_texture.h"
+#include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/skyline_packer.h"
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @class OpenGLTextureAtlas
+     * @brief Packs images into large shared RGBA8 pages at load time.
+     *
+     * Each added image is placed on the first page with room for it using
+     * a SkylinePacker; a new page is created when none has. The image is
+     * surrounded by a border of replicated edge pixels so linear filtering
+     * never samples a neighbouring image.
+     *
+     * Images are handed back as OpenGLSubTexture objects referring to
+     * their page and UV rectangle.
+     */
+    class OpenGLTextureAtlas {
+    public:
+        /**
+         * @brief Constructs an empty atlas.
+         *
+         * @param pageSize Width and height of each page in pixels.
+         * @param padding Border of replicated edge pixels around each image.
+         * @param filter Sampling filter of the pages (they never have mips).
+         */
+        explicit OpenGLTextureAtlas(int pageSize = 2048, int padding = 1,
+                                    TextureFilter filter = TextureFilter::Linear);
+
+        OpenGLTextureAtlas(const OpenGLTextureAtlas&) = delete;
+        OpenGLTextureAtlas& operator=(const OpenGLTextureAtlas&) = delete;
+
+        /**
+         * @brief Adds an image to the atlas.
+         *
+         * Requires a current OpenGL context.
+         *
+         * @param pixels Tightly packed pixel rows.
+         * @param width Image width.
+         * @param height Image height.
+         * @param channels Number of channels (3 = RGB, 4 = RGBA).
+         * @return Sub-texture for the image, or nullptr if it cannot fit on a page.
+         */
+        std::shared_ptr<OpenGLSubTexture> add(const uint8_t* pixels, int width, int height, int channels);
+
+        /**
+         * @brief Checks whether an image of the given size can be stored.
+         */
+        bool fits(int width, int height) const noexcept;
+
+        /**
+         * @brief Gets the number of pages created so far.
+         */
+        std::size_t getPageCount() const noexcept { return m_pages.size(); }
+
+        /**
+         * @brief Gets a page texture.
+         */
+        const std::shared_ptr<OpenGLTexture>& getPage(std::size_t index) const { return m_pages[index].texture; }
+
+        /**
+         * @brief Gets the fraction of a page covered by images (including padding).
+         */
+        float getOccupancy(std::size_t index) const { return m_pages[index].packer.getOccupancy(); }
+
+        /**
+         * @brief Gets the page size in pixels.
+         */
+        int getPageSize() const noexcept { return m_pageSize; }
+
+        /**
+         * @brief Gets the descriptor the pages are created with.
+         */
+        const TextureDesc& getPageDesc() const noexcept { return m_pageDesc; }
+
+        /**
+         * @brief Releases the atlas' references to its pages.
+         *
+         * Pages stay alive while sub-textures still use them.
+         */
+        void clear();
+
+    private:
+        /** A page texture and the packer tracking its free space */
+        struct Page {
+            std::shared_ptr<OpenGLTexture> texture;
+            SkylinePacker packer;
+        };
+
+        /**
+         * @brief Uploads an image with its replicated border into a page.
+         */
+        void upload(const Page& page, const PackedRect& slot,
+                    const uint8_t* pixels, int width, int height, int channels);
+
+        int m_pageSize;
+        int m_padding;
+        TextureDesc m_pageDesc;
+        std::vector<Page> m_pages;
+
+        /** Scratch buffer for the padded RGBA block */
+        std::vector<uint8_t> m_scratch;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @enum MipPolicy
+     * @brief Where a texture's mip chain comes from.
+     */
+    enum class MipPolicy : uint8_t {
+        /** Level 0 only; nothing is allocated or generated for smaller levels */
+        None,
+
+        /** Full chain generated by the driver after upload (glGenerateMipmap) */
+        Generate,
+
+        /** Levels supplied by the source, e.g. a KTX2 file; level 0 only otherwise */
+        Precomputed
+    };
+
+    /**
+     * @enum TextureFilter
+     * @brief Sampling filter, used for both minification and magnification.
+     *
+     * With mips, Linear samples trilinearly and Nearest picks the closest texel
+     * of the closest level.
+     */
+    enum class TextureFilter : uint8_t {
+        /** Crisp texels, for pixel art */
+        Nearest,
+
+        /** Bilinear (trilinear with mips) */
+        Linear
+    };
+
+    /**
+     * @enum TextureWrap
+     * @brief Addressing of texture coordinates outside [0, 1], on both axes.
+     */
+    enum class TextureWrap : uint8_t {
+        ClampToEdge,
+        Repeat,
+        MirroredRepeat
+    };
+
+    /**
+     * @enum TextureFormat
+     * @brief GPU storage format of uncompressed textures.
+     */
+    enum class TextureFormat : uint8_t {
+        /** RGBA8 for 4-channel sources, RGB8 for 3-channel ones, R8 for 1-channel ones */
+        Auto,
+        RGBA8,
+        RGB8,
+
+        /** sRGB-encoded color with linear alpha */
+        SRGB8_ALPHA8,
+
+        /** One channel, sampled as grayscale (r, r, r, 1) */
+        R8,
+
+        /** One channel stored as R8, sampled as white with it in alpha (1, 1, 1, r) */
+        Alpha8
+    };
+
+    /**
+     * @struct TextureDesc
+     * @brief How an OpenGLTexture is allocated and sampled.
+     *
+     * The default matches what the sprite renderer samples: one level,
+     * bilinear filtering, clamped edges.
+     */
+    struct TextureDesc {
+        MipPolicy mips = MipPolicy::None;
+        TextureFilter filter = TextureFilter::Linear;
+        TextureWrap wrap = TextureWrap::ClampToEdge;
+        TextureFormat format = TextureFormat::Auto;
+
+        /**
+         * @brief Nearest filtering without mips, for pixel art.
+         */
+        static TextureDesc pixelArt() noexcept {
+            TextureDesc desc;
+            desc.filter = TextureFilter::Nearest;
+            return desc;
+        }
+
+        /**
+         * @brief Uses the mip levels supplied by the source (KTX2 files).
+         */
+        static TextureDesc precomputed() noexcept {
+            TextureDesc desc;
+            desc.mips = MipPolicy::Precomputed;
+            return desc;
+        }
+
+        /**
+         * @brief Packs the descriptor into a small integer, for cache keys.
+         */
+        uint32_t getKey() const noexcept {
+            return static_cast<uint32_t>(mips)
+                 | (static_cast<uint32_t>(filter) << 4)
+                 | (static_cast<uint32_t>(wrap) << 8)
+                 | (static_cast<uint32_t>(format) << 12);
+        }
+
+        bool operator==(const TextureDesc& other) const noexcept { return getKey() == other.getKey(); }
+        bool operator!=(const TextureDesc& other) const noexcept { return getKey() != other.getKey(); }
+    };
+
+    /**
+     * @brief Gets the number of levels of a full mip chain down to 1x1.
+     */
+    int getFullMipCount(int width, int height) noexcept;
+
+    /**
+     * @brief Gets the GL_TEXTURE_MIN_FILTER value for a descriptor.
+     *
+     * @param mipmapped Whether the texture has more than one level.
+     */
+    int getGLMinFilter(const TextureDesc& desc, bool mipmapped) noexcept;
+
+    /**
+     * @brief Gets the GL_TEXTURE_MAG_FILTER value for a descriptor.
+     */
+    int getGLMagFilter(const TextureDesc& desc) noexcept;
+
+    /**
+     * @brief Gets the GL_TEXTURE_WRAP_S/T value for a descriptor.
+     */
+    int getGLWrap(const TextureDesc& desc) noexcept;
+
+    /**
+     * @brief Gets the sized internal format for a descriptor and source channel count.
+     */
+    unsigned int getGLInternalFormat(const TextureDesc& desc, int channels) noexcept;
+
+    /**
+     * @brief Gets the client pixel format (GL_RED, GL_RGB, GL_RGBA) for a channel count.
+     */
+    unsigned int getGLDataFormat(int channels) noexcept;
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "retronomicon/asset/image_asset.h"
+#include "retronomicon/graphics/opengl_texture.h"
+
+namespace retronomicon::opengl::graphics {
+
+    using retronomicon::asset::ImageAsset;
+
+    /**
+     * @class OpenGLTextureUploader
+     * @brief Loads textures in the background without stalling the render thread.
+     *
+     * enqueue() returns a non-resident OpenGLTexture immediately; it draws
+     * as a placeholder until its pixels are on the GPU. The work is split
+     * in three stages:
+     *  - worker threads decode the image (if not loaded yet) and convert
+     *    it to tightly packed RGBA8, or keep it as one byte per pixel for
+     *    single-channel images (R8 / Alpha8);
+     *  - update(), on the render thread, copies decoded images into pixel
+     *    buffer objects and starts the texture transfer from there, within
+     *    a per-call byte budget;
+     *  - a fence per transfer tells update() when the texture can be
+     *    swapped in without the draw waiting on the copy.
+     *
+     * Textures released before they become resident are dropped at the
+     * next stage. All GL work happens in update() and the destructor, which
+     * must run on the thread owning the context.
+     */
+    class OpenGLTextureUploader {
+    public:
+        /** Default bytes staged per update() */
+        static constexpr std::size_t DefaultBudget = 8u << 20;
+
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param workers Number of decoding threads (at least 1).
+         */
+        explicit OpenGLTextureUploader(std::size_t workers = 2);
+
+        /**
+         * @brief Stops the workers and releases staging buffers and fences.
+         *
+         * Textures still pending stay on their placeholder.
+         */
+        ~OpenGLTextureUploader();
+
+        OpenGLTextureUploader(const OpenGLTextureUploader&) = delete;
+        OpenGLTextureUploader& operator=(const OpenGLTextureUploader&) = delete;
+
+        /**
+         * @brief Queues an image for asynchronous upload.
+         *
+         * Requires a current OpenGL context the first time (the default
+         * placeholder is created lazily).
+         *
+         * @param image Image to upload; decoded on a worker if not loaded.
+         * @param desc Storage, mip and sampling options of the texture.
+         * @return Texture handle, resident once update() completes the upload.
+         */
+        std::shared_ptr<OpenGLTexture> enqueue(std::shared_ptr<ImageAsset> image, const TextureDesc& desc = {});
+
+        /**
+         * @brief Advances uploads; call once per frame on the render thread.
+         *
+         * Makes finished transfers resident and stages new ones until
+         * @p byteBudget bytes have been copied (at least one image per call).
+         *
+         * @param byteBudget Maximum bytes staged by this call.
+         */
+        void update(std::size_t byteBudget = DefaultBudget);
+
+        /**
+         * @brief Sets the texture shown while uploads are pending.
+         *
+         * Only affects textures enqueued afterwards. Defaults to a 1x1
+         * transparent texture.
+         */
+        void setPlaceholder(std::shared_ptr<OpenGLTexture> placeholder) { m_placeholder = std::move(placeholder); }
+
+        /**
+         * @brief Gets the number of textures not resident yet.
+         */
+        std::size_t getPendingCount() const;
+
+        /**
+         * @brief Gets the number of textures made resident so far.
+         */
+        std::size_t getCompletedCount() const noexcept { return m_completed; }
+
+    private:
+        /** An image travelling through the pipeline */
+        struct Job {
+            std::weak_ptr<OpenGLTexture> texture;
+            std::shared_ptr<ImageAsset> image;
+            TextureDesc desc;
+
+            /** Tightly packed RGBA8 or single-channel, filled by a worker */
+            std::vector<uint8_t> pixels;
+            int width = 0;
+            int height = 0;
+            int channels = 4;
+            bool decoded = false;
+        };
+
+        /** A pixel buffer object used as a transfer source */
+        struct Staging {
+            unsigned int buffer = 0;
+            std::size_t capacity = 0;
+        };
+
+        /** A transfer waiting for its fence */
+        struct Transfer {
+            std::weak_ptr<OpenGLTexture> texture;
+
+            /** Kept so the resident texture can be restored after an eviction */
+            std::shared_ptr<ImageAsset> source;
+
+            unsigned int textureId = 0;
+            int width = 0;
+            int height = 0;
+            int channels = 4;
+            int mipLevels = 1;
+            Staging staging;
+
+            /** GLsync, or nullptr without ARB_sync */
+            void* fence = nullptr;
+        };
+
+        /**
+         * @brief Worker loop: decodes and converts queued images.
+         */
+        void workerMain();
+
+        /**
+         * @brief Makes finished transfers resident and recycles their buffers.
+         */
+        void retireTransfers();
+
+        /**
+         * @brief Copies a decoded image into a staging buffer and starts its transfer.
+         */
+        void stage(Job& job);
+
+        /**
+         * @brief Gets a staging buffer of at least @p size bytes.
+         */
+        Staging acquireStaging(std::size_t size);
+
+        std::vector<std::thread> m_workers;
+
+        /** Guards m_queued, m_decoded and m_stopping */
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+
+        /** Waiting for a worker */
+        std::deque<std::unique_ptr<Job>> m_queued;
+
+        /** Decoded, waiting for update() */
+        std::deque<std::unique_ptr<Job>> m_decoded;
+
+        /** Jobs taken by a worker and not yet decoded */
+        std::size_t m_decoding = 0;
+
+        /** Render thread only */
+        std::vector<Transfer> m_transfers;
+        std::vector<Staging> m_idleStaging;
+        std::shared_ptr<OpenGLTexture> m_placeholder;
+        std::size_t m_completed = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "retronomicon/graphics/renderer/i_renderer.h"
+#include "retronomicon/graphics/renderer/opengl_render_queue.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_kernel.h"
+#include "retronomicon/graphics/renderer/opengl_text_layout.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::graphics::Texture;
+    using retronomicon::math::Vec2;
+    using retronomicon::math::Rect;
+    using retronomicon::graphics::Color;
+
+    /**
+     * @class OpenGLCommandBuffer
+     * @brief Records draw commands on any thread for later submission on the GL thread.
+     *
+     * The buffer implements the IRenderer drawing API, so scene code can
+     * render into it exactly as it would into OpenGLRenderer. Recording
+     * only transforms vertices and stores them in an OpenGLRenderQueue;
+     * no OpenGL call is made, which makes it safe to fill one buffer per
+     * worker thread in parallel.
+     *
+     * Once all workers are done, the thread owning the GL context passes
+     * the buffers to OpenGLRenderer::submit(). Buffers are merged in the
+     * order they are submitted, so submitting them in a fixed order (for
+     * example by worker index) gives identical output every frame
+     * regardless of thread timing.
+     *
+     * A single buffer must not be recorded from several threads at once.
+     * Textures referenced by recorded draws must stay alive until the
+     * buffer has been submitted.
+     */
+    class OpenGLCommandBuffer : public retronomicon::graphics::renderer::IRenderer {
+    public:
+        /**
+         * @brief Constructs an empty command buffer.
+         *
+         * @param width Width of the render target, reported by getWidth().
+         * @param height Height of the render target, reported by getHeight().
+         */
+        OpenGLCommandBuffer(int width, int height);
+
+        /**
+         * @brief Does nothing; a command buffer owns no GPU resources.
+         */
+        void init() override {}
+
+        /**
+         * @brief Does nothing; clearing the framebuffer is left to the renderer.
+         */
+        void clear() override {}
+
+        /**
+         * @brief Does nothing; use OpenGLRenderer::submit() to present recorded commands.
+         */
+        void show() override {}
+
+        /**
+         * @brief Discards all recorded commands.
+         */
+        void shutdown() override { reset(); }
+
+        /**
+         * @brief Records a texture draw using position, scale, and rotation.
+         *
+         * @param texture Texture to render.
+         * @param position World-space position.
+         * @param scale Scaling factor.
+         * @param rotation Rotation in degrees.
+         * @param alpha Alpha transparency multiplier.
+         */
+        void render(std::shared_ptr<Texture> texture,
+                    const Vec2& position,
+                    const Vec2& scale,
+                    float rotation = 0.0f,
+                    float alpha = 1.0f) override;
+
+        /**
+         * @brief Records a textured quad with explicit source and target rectangles.
+         *
+         * @param texture Texture to render.
+         * @param target Target rectangle in world or screen space.
+         * @param source Source rectangle within the texture.
+         * @param rotation Rotation in degrees.
+         * @param alpha Alpha transparency multiplier.
+         * @param color Color tint applied to the quad.
+         */
+        void renderQuad(std::shared_ptr<Texture> texture,
+                        const Rect& target,
+                        const Rect& source,
+                        float rotation = 0.0f,
+                        float alpha = 1.0f,
+                        const Color& color = Color::White()) override;
+
+        /**
+         * @brief Records an instanced draw; the instances are copied.
+         *
+         * @param texture Texture shared by all instances.
+         * @param instances Per-instance transform, UV rect and color.
+         * @param count Number of instances.
+         */
+        void renderInstanced(std::shared_ptr<Texture> texture,
+                             const SpriteInstance* instances,
+                             std::size_t count);
+
+        /**
+         * @brief Records many sprites from SoA arrays using the SIMD kernel.
+         *
+         * @param texture Texture shared by all sprites.
+         * @param sprites Position, size, anchor, rotation, UV and color arrays.
+         * @param count Number of sprites.
+         */
+        void renderSprites(std::shared_ptr<Texture> texture,
+                           const SpriteArrays& sprites,
+                           std::size_t count);
+
+        /**
+         * @brief Records a string drawn with a font atlas as one run of quads.
+         *
+         * See OpenGLRenderer::drawText().
+         */
+        void drawText(std::shared_ptr<Texture> atlas,
+                      const OpenGLFontAsset& font,
+                      std::string_view text,
+                      const Vec2& position,
+                      const Color& color = Color::White(),
+                      float scale = 1.0f);
+
+        /**
+         * @brief Sets the layer and depth used for subsequent draws.
+         *
+         * See OpenGLRenderer::setDrawOrder().
+         */
+        void setDrawOrder(uint8_t layer, uint32_t depth = OpenGLRenderQueue::SequentialDepth);
+
+        /**
+         * @brief Sets the blend mode used for subsequent draws.
+         */
+        void setBlendMode(BlendMode mode) { m_blendMode = mode; }
+
+        /**
+         * @brief Sets the sampler object used for subsequent draws.
+         *
+         * Sampler objects can only be created on the GL thread; obtain the
+         * name with OpenGLRenderer::getSamplerId() beforehand.
+         *
+         * @param samplerId Sampler name, or 0 to use the texture's own parameters.
+         */
+        void setSampler(unsigned int samplerId) { m_samplerId = samplerId; }
+
+        /**
+         * @brief Discards recorded commands and resets draw order, blend mode and sampler.
+         *
+         * Allocated capacity is kept for the next frame.
+         */
+        void reset();
+
+        /**
+         * @brief Checks whether any command has been recorded.
+         */
+        bool empty() const noexcept { return m_queue.empty(); }
+
+        /**
+         * @brief Gets the recorded commands.
+         */
+        const OpenGLRenderQueue& getQueue() const noexcept { return m_queue; }
+
+        /**
+         * @brief Gets the render target width.
+         */
+        int getWidth() const override { return m_width; }
+
+        /**
+         * @brief Gets the render target height.
+         */
+        int getHeight() const override { return m_height; }
+
+    private:
+        /** Render target size */
+        int m_width;
+        int m_height;
+
+        /** Recorded commands and their payloads */
+        OpenGLRenderQueue m_queue;
+
+        /** Layer and depth for subsequent draws */
+        uint8_t m_drawLayer = 0;
+        uint32_t m_drawDepth = OpenGLRenderQueue::SequentialDepth;
+
+        /** Blend mode for subsequent draws */
+        BlendMode m_blendMode = BlendMode::Alpha;
+
+        /** Sampler object for subsequent draws (0 = texture parameters) */
+        unsigned int m_samplerId = 0;
+
+        /** Glyph quads of the string being recorded */
+        std::vector<SpriteVertex> m_textScratch;
+    };
+
+} // namespace retronomicon::opengl::graphics::renderer
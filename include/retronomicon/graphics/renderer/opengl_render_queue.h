@@ -0,0 +1,318 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "retronomicon/graphics/texture.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_instancer.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::graphics::Texture;
+
+    /**
+     * @enum BlendMode
+     * @brief Blend equations supported by the sprite renderer.
+     */
+    enum class BlendMode : uint8_t {
+        /** Straight alpha: src * a + dst * (1 - a) */
+        Alpha = 0,
+
+        /** Additive: src * a + dst */
+        Additive = 1,
+
+        /** Multiply: src * dst + dst * (1 - a) */
+        Multiply = 2,
+
+        /** Blending disabled */
+        Opaque = 3
+    };
+
+    /**
+     * @class OpenGLRenderQueue
+     * @brief Deferred list of draw commands ordered by a 64-bit sort key.
+     *
+     * Each command carries a key and a small payload that references
+     * vertices or instances stored in per-frame arenas owned by the queue.
+     * sort() orders the commands with a stable LSD radix sort, after which
+     * they can be executed front to back.
+     *
+     * Key layout, most significant bits first:
+     *
+     *   | layer (8) | depth (24) | blend (2) | shader (6) | texture (24) |
+     *
+     * Layers are drawn in increasing order and, inside a layer, depth
+     * orders draws back to front (painter's order). Only draws sharing
+     * both layer and depth are regrouped by blend mode, shader and
+     * texture to minimize state changes; draws with identical keys keep
+     * their submission order. The texture field identifies a texture and
+     * sampler pair.
+     *
+     * Keys built by makeDrawKey() with SequentialDepth number the draws
+     * in submission order, so nothing is regrouped unless the caller
+     * gives several draws the same explicit depth.
+     */
+    class OpenGLRenderQueue {
+    public:
+        /** Bit widths of the key fields */
+        static constexpr unsigned int LayerBits   = 8;
+        static constexpr unsigned int DepthBits   = 24;
+        static constexpr unsigned int BlendBits   = 2;
+        static constexpr unsigned int ShaderBits  = 6;
+        static constexpr unsigned int TextureBits = 24;
+
+        /** Bit offsets of the key fields */
+        static constexpr unsigned int TextureShift = 0;
+        static constexpr unsigned int ShaderShift  = TextureShift + TextureBits;
+        static constexpr unsigned int BlendShift   = ShaderShift + ShaderBits;
+        static constexpr unsigned int DepthShift   = BlendShift + BlendBits;
+        static constexpr unsigned int LayerShift   = DepthShift + DepthBits;
+
+        /** Largest depth value representable in a key */
+        static constexpr uint32_t MaxDepth = (1u << DepthBits) - 1;
+
+        /** Depth requesting the next submission number (see makeDrawKey()) */
+        static constexpr uint32_t SequentialDepth = 0xFFFFFFFFu;
+
+        /** Shader slots used by the sprite renderer */
+        static constexpr uint32_t ShaderSprite      = 0;
+        static constexpr uint32_t ShaderInstanced   = 1;
+        static constexpr uint32_t ShaderSpriteArray = 2;
+        static constexpr uint32_t ShaderDistanceField = 3;
+
+        /**
+         * @enum CommandType
+         * @brief Kind of payload attached to a command.
+         */
+        enum class CommandType : uint8_t {
+            /** Pre-transformed quads stored in the vertex arena */
+            Quads,
+
+            /** Sprite instances stored in the instance arena */
+            Instances
+        };
+
+        /**
+         * @struct Command
+         * @brief Sort key plus payload of a single deferred draw.
+         */
+        struct Command {
+            /** Sort key built with makeKey() */
+            uint64_t key = 0;
+
+            /** OpenGL texture object sampled by the draw */
+            unsigned int textureId = 0;
+
+            /** Sampler object bound with the texture (0 = texture parameters) */
+            unsigned int samplerId = 0;
+
+            /** Texture recorded off the render thread; textureId is resolved from it by append() */
+            Texture* source = nullptr;
+
+            /** First quad (Quads) or instance (Instances) in the arena */
+            uint32_t first = 0;
+
+            /** Number of quads or instances */
+            uint32_t count = 0;
+
+            /** Payload kind */
+            CommandType type = CommandType::Quads;
+
+            /** Depth is a submission number, rebased by append() */
+            bool sequential = false;
+        };
+
+        /**
+         * @struct DrawKey
+         * @brief Sort key of a draw plus how its depth was chosen.
+         */
+        struct DrawKey {
+            /** Sort key */
+            uint64_t key = 0;
+
+            /** Depth is a submission number (SequentialDepth was requested) */
+            bool sequential = false;
+        };
+
+        /**
+         * @brief Packs the sort key fields into a 64-bit key.
+         *
+         * Values wider than their field are clamped (depth) or masked.
+         */
+        static uint64_t makeKey(uint8_t layer,
+                                uint32_t depth,
+                                BlendMode blend,
+                                uint32_t shader,
+                                uint32_t textureSlot);
+
+        /**
+         * @brief Builds the key of the next draw recorded into this queue.
+         *
+         * With SequentialDepth the draw is numbered after everything
+         * recorded before it, keeping painter's order within the layer.
+         * Consecutive draws sharing layer, blend mode, shader and texture
+         * share a number, so they still merge into one command. Numbers
+         * start at 1 and restart on clear(); past MaxDepth they saturate
+         * and later draws of the layer may be regrouped. Any other depth
+         * is used as given, and draws with equal explicit depths may be
+         * regrouped by state. Pass the result to pushQuads() or
+         * pushInstances().
+         */
+        DrawKey makeDrawKey(uint8_t layer,
+                            uint32_t depth,
+                            BlendMode blend,
+                            uint32_t shader,
+                            uint32_t textureSlot);
+
+        /**
+         * @brief Extracts the blend mode from a key.
+         */
+        static BlendMode getBlend(uint64_t key) {
+            return static_cast<BlendMode>((key >> BlendShift) & ((1u << BlendBits) - 1));
+        }
+
+        /**
+         * @brief Extracts the shader slot from a key.
+         */
+        static uint32_t getShader(uint64_t key) {
+            return static_cast<uint32_t>((key >> ShaderShift) & ((1u << ShaderBits) - 1));
+        }
+
+        /**
+         * @brief Maps an OpenGL texture and sampler pair to a compact per-frame slot for the key.
+         *
+         * Slots are handed out in first-use order and reset by clear().
+         */
+        uint32_t getTextureSlot(unsigned int textureId, unsigned int samplerId = 0);
+
+        /**
+         * @brief Maps an engine texture and sampler pair to a slot for the key.
+         *
+         * Used instead of getTextureSlot() when recording off the render
+         * thread, where the GL texture is not known yet. append() replaces
+         * these slots.
+         */
+        uint32_t getSourceSlot(Texture* source, unsigned int samplerId = 0);
+
+        /**
+         * @brief Records a draw of count quads.
+         *
+         * @param key Sort key from makeDrawKey().
+         * @param textureId OpenGL texture sampled by the quads.
+         * @param count Number of quads.
+         * @param samplerId Sampler object bound with the texture.
+         * @param source Texture to resolve on submission (recording off the render thread).
+         * @return Pointer to count * 4 vertices to be filled by the caller,
+         *         valid until the next push.
+         */
+        SpriteVertex* pushQuads(const DrawKey& key, unsigned int textureId, std::size_t count,
+                                unsigned int samplerId = 0, Texture* source = nullptr);
+
+        /**
+         * @brief Records an instanced draw, copying the instances.
+         *
+         * @param key Sort key from makeDrawKey().
+         * @param textureId OpenGL texture sampled by the instances.
+         * @param instances Instance data.
+         * @param count Number of instances.
+         * @param samplerId Sampler object bound with the texture.
+         * @param source Texture to resolve on submission (recording off the render thread).
+         * @return Pointer to the copied instances, valid until the next push.
+         */
+        SpriteInstance* pushInstances(const DrawKey& key, unsigned int textureId,
+                           const SpriteInstance* instances, std::size_t count,
+                           unsigned int samplerId = 0, Texture* source = nullptr);
+
+        /**
+         * @brief Appends all commands of another queue.
+         *
+         * Payloads are copied into this queue's arenas and texture slots
+         * are remapped, so queues recorded independently (e.g. on worker
+         * threads) can be merged. Commands carrying a source texture get
+         * their GL texture resolved here, restoring evicted textures, so
+         * append() must run on the render thread. Submission numbers are rebased after
+         * the ones already recorded, so sequential draws of the other
+         * queue are drawn after those of this one.
+         *
+         * @param other Queue to merge; left unchanged.
+         */
+        void append(const OpenGLRenderQueue& other);
+
+        /**
+         * @brief Orders the recorded commands by key.
+         *
+         * Uses a stable 8-bit LSD radix sort, skipping passes over bytes
+         * that are identical for every key.
+         */
+        void sort();
+
+        /**
+         * @brief Drops all commands and arena contents.
+         *
+         * Capacity is kept so steady-state frames do not allocate.
+         */
+        void clear();
+
+        /**
+         * @brief Checks whether any command is recorded.
+         */
+        bool empty() const noexcept { return m_commands.empty(); }
+
+        /**
+         * @brief Gets the recorded commands (sorted after sort()).
+         */
+        const std::vector<Command>& getCommands() const noexcept { return m_commands; }
+
+        /**
+         * @brief Gets the first vertex of a Quads command.
+         */
+        const SpriteVertex* getVertices(const Command& command) const {
+            return m_vertices.data() + std::size_t(command.first) * OpenGLSpriteBatch::VerticesPerQuad;
+        }
+
+        /**
+         * @brief Gets the first instance of an Instances command.
+         */
+        const SpriteInstance* getInstances(const Command& command) const {
+            return m_instances.data() + command.first;
+        }
+
+    private:
+        /** Recorded commands */
+        std::vector<Command> m_commands;
+
+        /** Ping-pong buffer for the radix sort */
+        std::vector<Command> m_scratch;
+
+        /** Vertices of all Quads commands */
+        std::vector<SpriteVertex> m_vertices;
+
+        /** Instances of all Instances commands */
+        std::vector<SpriteInstance> m_instances;
+
+        /** (sampler << 32 | texture) -> key slot */
+        std::unordered_map<uint64_t, uint32_t> m_textureSlots;
+
+        /** (source, sampler) -> key slot, for draws recorded off the render thread */
+        std::map<std::pair<Texture*, unsigned int>, uint32_t> m_sourceSlots;
+
+        /** Last lookup, since consecutive draws usually share a texture */
+        uint64_t m_lastBinding = 0;
+        uint32_t m_lastSlot = 0;
+        std::pair<Texture*, unsigned int> m_lastSource{ nullptr, 0 };
+        uint32_t m_lastSourceSlot = 0;
+
+        /** Submission number of the last sequential draw */
+        uint32_t m_sequence = 0;
+
+        /** Key of the last sequential draw, and whether there is one */
+        uint64_t m_sequenceKey = 0;
+        bool m_sequenced = false;
+    };
+
+} // namespace retronomicon::opengl::graphics::renderer
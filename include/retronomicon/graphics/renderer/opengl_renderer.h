@@ -2,8 +2,23 @@
 
 #include "retronomicon/graphics/renderer/i_renderer.h"
 #include "retronomicon/graphics/opengl_color.h"
+#include "retronomicon/graphics/opengl_sampler_cache.h"
+#include "retronomicon/graphics/opengl_shader_program.h"
+#include "retronomicon/graphics/opengl_stream_buffer.h"
+#include "retronomicon/graphics/spatial_grid.h"
+#include "retronomicon/graphics/renderer/opengl_command_buffer.h"
+#include "retronomicon/graphics/renderer/opengl_render_queue.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_instancer.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_kernel.h"
+#include "retronomicon/graphics/renderer/opengl_text_layout.h"
+#include "retronomicon/graphics/renderer/opengl_texture_region.h"
+#include "retronomicon/graphics/renderer/opengl_tilemap.h"
 
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
 
@@ -14,6 +29,65 @@ namespace retronomicon::opengl::graphics::renderer {
     using retronomicon::math::Rect;
     using retronomicon::graphics::Color;
     using retronomicon::opengl::graphics::OpenGLColor;
+    using retronomicon::opengl::graphics::OpenGLShaderProgram;
+    using retronomicon::opengl::graphics::OpenGLStreamBuffer;
+    using retronomicon::opengl::graphics::OpenGLSamplerCache;
+    using retronomicon::opengl::graphics::SamplerDesc;
+    using retronomicon::opengl::graphics::Bounds2D;
+
+    /**
+     * @struct RenderStats
+     * @brief Per-frame rendering counters.
+     */
+    struct RenderStats {
+        /** Draw calls issued during the frame */
+        std::size_t drawCalls = 0;
+
+        /** Quads submitted during the frame (batched and instanced) */
+        std::size_t quads = 0;
+
+        /** Quads drawn through the instanced path */
+        std::size_t instances = 0;
+
+        /** Binding / state calls sent to the driver */
+        std::size_t stateChanges = 0;
+
+        /** Redundant binding / state calls skipped by OpenGLStateCache */
+        std::size_t stateChangesElided = 0;
+
+        /** Commands sorted and executed from the render queue */
+        std::size_t queuedCommands = 0;
+
+        /** Quads and instances rejected by viewport culling */
+        std::size_t culled = 0;
+
+        /** Quads and instances that passed viewport culling */
+        std::size_t visible = 0;
+    };
+
+    /**
+     * @struct TextEffect
+     * @brief Outline and drop shadow applied to distance field text.
+     *
+     * Widths are fractions of the font's distance spread, so the effect
+     * looks the same at every text size.
+     */
+    struct TextEffect {
+        /** Outline color */
+        Color outlineColor{0.0f, 0.0f, 0.0f, 1.0f};
+
+        /** Outline thickness, 0 (none) to 1 (the whole spread) */
+        float outlineWidth = 0.0f;
+
+        /** Shadow color; a zero alpha disables the shadow */
+        Color shadowColor{0.0f, 0.0f, 0.0f, 0.0f};
+
+        /** Shadow offset in atlas pixels */
+        Vec2 shadowOffset{0.0f, 0.0f};
+
+        /** Shadow edge blur, 0 (hard) to 1 (the whole spread) */
+        float shadowSoftness = 0.0f;
+    };
 
     /**
      * @class OpenGLRenderer
@@ -24,6 +98,14 @@ namespace retronomicon::opengl::graphics::renderer {
      *  - Initializing OpenGL rendering resources (VAO, VBO, shaders)
      *  - Clearing and presenting frames
      *  - Rendering textured quads
+     *  - Batching quads into few draw calls, each sampling up to
+     *    GL_MAX_TEXTURE_IMAGE_UNITS textures through a sampler array
+     *  - Sorting deferred draws by layer, depth and state (see OpenGLRenderQueue)
+     *  - Optionally skipping quads that lie entirely outside the viewport
+     *  - Drawing static tile layers from cached chunk geometry (see OpenGLTilemap)
+     *  - Drawing distance field text with an outline and drop shadow
+     *  - Sharing sampler objects, so one texture can be drawn with
+     *    different filtering without a second upload
      *  - Managing viewport dimensions
      *
      * The renderer operates on an existing GLFW window and does not
@@ -66,7 +148,7 @@ namespace retronomicon::opengl::graphics::renderer {
         /**
          * @brief Presents the rendered frame.
          *
-         * Flushes rendering commands and swaps buffers if required.
+         * Flushes pending batched quads and swaps buffers if required.
          */
         void show() override;
 
@@ -111,6 +193,234 @@ namespace retronomicon::opengl::graphics::renderer {
                         float alpha = 1.0f,
                         const Color& color = Color::White()) override;
 
+        /**
+         * @brief Renders many sprites sharing one texture with instancing.
+         *
+         * The sprites are drawn with one instanced draw call per chunk
+         * (array-pool textures are expanded into batched quads instead);
+         * in batching mode the instances are copied into the render queue
+         * and drawn when it is executed. If the driver lacks instanced arrays, the instances are
+         * expanded on the CPU and drawn through the regular batch.
+         *
+         * @param texture Texture shared by all instances.
+         * @param instances Per-instance transform, UV rect and color.
+         * @param count Number of instances.
+         */
+        void renderInstanced(std::shared_ptr<Texture> texture,
+                             const SpriteInstance* instances,
+                             std::size_t count);
+
+        /**
+         * @brief Renders many sprites sharing one texture from SoA arrays.
+         *
+         * Vertices are generated with the SIMD sprite kernel straight into
+         * the batch, several sprites per instruction, instead of one
+         * renderQuad() call per sprite.
+         *
+         * @param texture Texture shared by all sprites.
+         * @param sprites Position, size, anchor, rotation, UV and color arrays.
+         * @param count Number of sprites.
+         */
+        void renderSprites(std::shared_ptr<Texture> texture,
+                           const SpriteArrays& sprites,
+                           std::size_t count);
+
+        /**
+         * @brief Draws a string with a font atlas.
+         *
+         * The string is laid out with layoutText() and all its glyphs are
+         * submitted as one run of quads, so a whole HUD shares the draw
+         * calls of the other sprites using the atlas.
+         *
+         * @param atlas Texture created from @p font (OpenGLTextureManager::createTexture).
+         * @param font Loaded font providing the glyph metrics.
+         * @param text Text to draw; '\n' starts a new line.
+         * @param position Top-left corner of the first line.
+         * @param color Text color.
+         * @param scale Size multiplier applied to the font metrics.
+         *
+         * Fonts loaded in distance field mode are drawn with the distance
+         * field shader and the current TextEffect, and stay sharp at any
+         * scale; pass targetSize / font.getPointSize() to draw at a given
+         * pixel size.
+         */
+        void drawText(std::shared_ptr<Texture> atlas,
+                      const OpenGLFontAsset& font,
+                      std::string_view text,
+                      const Vec2& position,
+                      const Color& color = Color::White(),
+                      float scale = 1.0f);
+
+        /**
+         * @brief Draws a UTF-8 string with glyphs from a glyph cache.
+         *
+         * Glyphs not cached yet are rasterized and uploaded first, so any
+         * character of the font can be drawn. Glyphs sharing a cache page
+         * are submitted together, like the atlas overload.
+         *
+         * @param cache Glyph cache of the font to draw with.
+         * @param text UTF-8 text; '\n' starts a new line.
+         * @param position Top-left corner of the first line.
+         * @param color Text color.
+         * @param scale Size multiplier applied to the font metrics.
+         */
+        void drawText(OpenGLGlyphCache& cache,
+                      std::string_view text,
+                      const Vec2& position,
+                      const Color& color = Color::White(),
+                      float scale = 1.0f);
+
+        /**
+         * @brief Merges a command buffer recorded on another thread into the frame.
+         *
+         * Must be called on the thread owning the GL context, after the
+         * recording thread is done with the buffer. Commands are merged in
+         * submission order and then sorted with the rest of the frame, so
+         * submitting buffers in a fixed order gives deterministic output.
+         * GL textures are looked up here rather than while recording, so
+         * textures evicted in the meantime are re-uploaded before use.
+         * The buffer is reset afterwards and can be reused next frame.
+         *
+         * Outside batching mode the merged commands are drawn immediately.
+         *
+         * @param buffer Recorded commands.
+         */
+        void submit(OpenGLCommandBuffer& buffer);
+
+        /**
+         * @brief Draws the visible chunks of a tile layer.
+         *
+         * Uses the sprite shader, the current blend mode and sampler.
+         * Draws recorded so far are flushed first and the chunks are drawn
+         * immediately, so tile layers should be rendered before the
+         * sprites on top of them. One draw call is issued per visible,
+         * non-empty chunk.
+         *
+         * @param tilemap Tile layer to draw.
+         */
+        void renderTilemap(OpenGLTilemap& tilemap);
+
+        /**
+         * @brief Sets the layer and depth used for subsequent draws.
+         *
+         * Only affects draws recorded in batching mode. Layers are drawn
+         * in increasing order. By default draws within a layer keep their
+         * submission order (painter's order). An explicit depth overrides
+         * it: higher depths are drawn later, and draws with equal layer
+         * and depth may be reordered to group them by blend mode, shader
+         * and texture. Use one explicit depth for order-independent draws
+         * such as opaque or non-overlapping sprites.
+         *
+         * @param layer Draw layer.
+         * @param depth Depth within the layer (clamped to 24 bits), or
+         *        OpenGLRenderQueue::SequentialDepth for submission order.
+         */
+        void setDrawOrder(uint8_t layer, uint32_t depth = OpenGLRenderQueue::SequentialDepth);
+
+        /**
+         * @brief Sets the blend mode used for subsequent draws.
+         *
+         * @param mode Blend mode.
+         */
+        void setBlendMode(BlendMode mode);
+
+        /**
+         * @brief Samples subsequent draws with a shared sampler object.
+         *
+         * The sampler overrides the filter and wrap parameters of the
+         * texture. Draws of the same texture with the same sampler still
+         * batch together. Ignored without sampler object support.
+         *
+         * @param desc Sampling state.
+         */
+        void setSampler(const SamplerDesc& desc);
+
+        /**
+         * @brief Samples subsequent draws with each texture's own parameters.
+         */
+        void clearSampler() { m_sampler = 0; }
+
+        /**
+         * @brief Gets the sampler object for a descriptor, creating it on first use.
+         *
+         * Must be called on the GL thread; the name can then be passed to
+         * OpenGLCommandBuffer::setSampler() on any thread.
+         *
+         * @return Sampler name, or 0 without sampler object support.
+         */
+        unsigned int getSamplerId(const SamplerDesc& desc) { return m_samplers.get(desc); }
+
+        /**
+         * @brief Sets the outline and shadow of distance field text.
+         *
+         * The effect is a shader uniform, so text already submitted is
+         * flushed first and drawn with the previous effect.
+         *
+         * @param effect Effect for subsequent distance field text.
+         */
+        void setTextEffect(const TextEffect& effect);
+
+        /**
+         * @brief Starts batching mode.
+         *
+         * Until endBatch() is called, render calls are recorded into the
+         * render queue instead of being drawn. The queue is sorted and
+         * executed on flush(), endBatch() or show(), merging draws that
+         * share state into as few draw calls as possible. Overlapping
+         * draws keep their submission order unless setDrawOrder() gives
+         * them an explicit depth.
+         */
+        void beginBatch();
+
+        /**
+         * @brief Ends batching mode and draws all recorded commands.
+         */
+        void endBatch();
+
+        /**
+         * @brief Sorts and draws all recorded commands without leaving batching mode.
+         */
+        void flush();
+
+        /**
+         * @brief Checks whether the renderer is currently batching.
+         *
+         * @return true between beginBatch() and endBatch().
+         */
+        bool isBatching() const { return m_batching; }
+
+        /**
+         * @brief Enables or disables viewport culling.
+         *
+         * When enabled, renderQuad() and renderInstanced() test the
+         * bounding box of each rotated quad against getViewBounds() and
+         * drop those entirely outside before any vertex is written.
+         * renderSprites() is not culled per sprite; cull retained sprites
+         * with a SpatialGrid query before building the arrays.
+         *
+         * @param enabled Whether to cull.
+         */
+        void setCulling(bool enabled) { m_culling = enabled; }
+
+        /**
+         * @brief Checks whether viewport culling is enabled.
+         */
+        bool isCulling() const { return m_culling; }
+
+        /**
+         * @brief Gets the world-space area covered by the projection.
+         *
+         * Suitable as the view of a SpatialGrid query.
+         */
+        Bounds2D getViewBounds() const { return { 0.0f, 0.0f, float(m_width), float(m_height) }; }
+
+        /**
+         * @brief Gets the counters of the last presented frame.
+         *
+         * @return Draw call and quad counts.
+         */
+        const RenderStats& getFrameStats() const { return m_frameStats; }
+
         /**
          * @brief Gets the current render width.
          *
@@ -136,22 +446,62 @@ namespace retronomicon::opengl::graphics::renderer {
 
     private:
         /**
-         * @brief Compiles an OpenGL shader.
+         * @brief Reserves vertices for quads, either in the queue or the batch.
+         *
+         * @param region Texture object and target sampled by the quads.
+         * @param requested Number of quads wanted.
+         * @param granted Receives the number of quads reserved.
+         * @return Pointer to granted * 4 vertices.
+         */
+        SpriteVertex* reserveQuads(const TextureRegion& region, std::size_t requested, std::size_t& granted);
+
+        /**
+         * @brief Tests a quad against the view, updating the culling counters.
+         *
+         * @return true if the quad may be visible.
+         */
+        bool isVisible(const Bounds2D& bounds);
+
+        /**
+         * @brief Drops instances outside the view.
          *
-         * @param type Shader type (e.g. GL_VERTEX_SHADER).
-         * @param src GLSL shader source code.
-         * @return Compiled shader object ID.
+         * @return @p instances if all are visible, otherwise m_instanceScratch
+         *         holding the visible ones; @p count is updated.
+         */
+        const SpriteInstance* cullInstances(const SpriteInstance* instances, std::size_t& count);
+
+        /**
+         * @brief Sorts the render queue and replays it through the batch and instancer.
          */
-        unsigned int compileShader(unsigned int type, const char* src);
+        void executeQueue();
 
         /**
-         * @brief Creates a shader program from vertex and fragment shaders.
+         * @brief Draws the quads pending in the sprite batch.
+         */
+        void flushBatch();
+
+        /**
+         * @brief Uploads the current TextEffect to the distance field shader.
+         */
+        void applyTextEffect();
+
+        /**
+         * @brief Drops glyph quads of m_textScratch outside the view, keeping their pages in step.
          *
-         * @param vertSrc Vertex shader source code.
-         * @param fragSrc Fragment shader source code.
-         * @return Linked shader program ID.
+         * @param pages Cache page per quad, or nullptr.
+         * @return Number of quads kept at the front.
          */
-        unsigned int createShaderProgram(const char* vertSrc, const char* fragSrc);
+        std::size_t cullGlyphs(std::size_t count, uint16_t* pages);
+
+        /**
+         * @brief Submits laid out glyph quads sampling one texture region.
+         */
+        void submitGlyphs(const TextureRegion& region, const SpriteVertex* quads, std::size_t count);
+
+        /**
+         * @brief Switches GL blend state, flushing pending quads first.
+         */
+        void applyBlendMode(BlendMode mode);
 
         /** Current render width in pixels */
         int m_width;
@@ -165,14 +515,81 @@ namespace retronomicon::opengl::graphics::renderer {
         /** Whether the renderer has been initialized */
         bool m_initialized = false;
 
-        /** Vertex Array Object */
-        unsigned int m_VAO = 0;
+        /** Whether render calls are being batched */
+        bool m_batching = false;
+
+        /** Ring buffer shared by all per-frame geometry uploads */
+        OpenGLStreamBuffer m_stream;
+
+        /** Dynamic quad batch shared by all sprite draws */
+        OpenGLSpriteBatch m_batch;
+
+        /** Instanced sprite path (unused if unsupported by the driver) */
+        OpenGLSpriteInstancer m_instancer;
+
+        /** Whether instanced arrays are available */
+        bool m_instancingSupported = false;
+
+        /** Sprite shader program */
+        OpenGLShaderProgram m_spriteShader;
+
+        /** Cached uniform IDs of the sprite shader */
+        OpenGLShaderProgram::UniformId m_uProjection = OpenGLShaderProgram::InvalidId;
+        OpenGLShaderProgram::UniformId m_uTextures   = OpenGLShaderProgram::InvalidId;
+
+        /** Sprite shader sampling texture array layers */
+        OpenGLShaderProgram m_arrayShader;
+
+        /** Text shader reading a distance field atlas */
+        OpenGLShaderProgram m_sdfShader;
+
+        /** Effect applied by the distance field shader */
+        TextEffect m_textEffect;
+
+        /** Deferred commands recorded in batching mode */
+        OpenGLRenderQueue m_queue;
+
+        /** Layer and depth for subsequent draws */
+        uint8_t m_drawLayer = 0;
+        uint32_t m_drawDepth = OpenGLRenderQueue::SequentialDepth;
+
+        /** Blend mode requested for subsequent draws */
+        BlendMode m_blendMode = BlendMode::Alpha;
+
+        /** Blend mode currently set in GL */
+        BlendMode m_appliedBlend = BlendMode::Alpha;
+
+        /** Sampler objects shared by all draws */
+        OpenGLSamplerCache m_samplers;
+
+        /** Sampler for subsequent draws (0 = texture parameters) */
+        unsigned int m_sampler = 0;
+
+        /** Remapped copy of instances drawn from an atlas sub-texture */
+        std::vector<SpriteInstance> m_instanceScratch;
+
+        /** Glyph quads of the string being drawn */
+        std::vector<SpriteVertex> m_textScratch;
+
+        /** Glyph cache page of each quad in m_textScratch */
+        std::vector<uint16_t> m_textPages;
+
+        /** Commands executed since the last presented frame */
+        std::size_t m_queuedCommands = 0;
+
+        /** Whether quads outside the view are dropped */
+        bool m_culling = false;
+
+        /** Tilemap chunk draws since the last presented frame */
+        std::size_t m_tilemapDrawCalls = 0;
+        std::size_t m_tilemapQuads = 0;
 
-        /** Vertex Buffer Object */
-        unsigned int m_VBO = 0;
+        /** Culling results since the last presented frame */
+        std::size_t m_culledQuads = 0;
+        std::size_t m_visibleQuads = 0;
 
-        /** Active shader program */
-        unsigned int m_shaderProgram = 0;
+        /** Counters of the last presented frame */
+        RenderStats m_frameStats;
     };
 
 } // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "retronomicon/graphics/opengl_stream_buffer.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::opengl::graphics::OpenGLStreamBuffer;
+
+    /**
+     * @struct SpriteVertex
+     * @brief Packed vertex layout used by the batched sprite path.
+     *
+     * Positions are already transformed into world space on the CPU,
+     * so the vertex shader only needs to apply the projection.
+     * The color is stored as normalized RGBA8 to keep the vertex small.
+     */
+    struct SpriteVertex {
+        /** World-space position */
+        float x, y;
+
+        /** Texture coordinates */
+        float u, v;
+
+        /** Color tint (alpha already multiplied in) */
+        uint8_t r, g, b, a;
+
+        /** Layer sampled when drawing from a texture array, 0 otherwise */
+        uint16_t layer;
+
+        /** Entry of the batch texture slot table (set by the batch) */
+        uint16_t slot;
+    };
+
+    /**
+     * @enum TextureTarget
+     * @brief Kind of texture object a batch samples from.
+     */
+    enum class TextureTarget : uint8_t {
+        /** GL_TEXTURE_2D */
+        Texture2D,
+
+        /** GL_TEXTURE_2D_ARRAY, layer taken from SpriteVertex::layer */
+        Texture2DArray,
+
+        /** GL_TEXTURE_2D whose alpha holds a signed distance field (text) */
+        DistanceField
+    };
+
+    /**
+     * @brief Writes the four vertices of a rotated, anchored quad.
+     *
+     * Corners are emitted in the order (0,0) (1,0) (1,1) (0,1) of the
+     * quad's local space, matching the batch index buffer. The layer and
+     * slot are set to 0.
+     *
+     * @param out Destination for four vertices.
+     * @param x World-space X of the anchor point.
+     * @param y World-space Y of the anchor point.
+     * @param width Quad width.
+     * @param height Quad height.
+     * @param anchorX Anchor as a fraction of the width.
+     * @param anchorY Anchor as a fraction of the height.
+     * @param rotation Rotation around the anchor in degrees.
+     * @param u0 Left texture coordinate.
+     * @param v0 Top texture coordinate.
+     * @param u1 Right texture coordinate.
+     * @param v1 Bottom texture coordinate.
+     * @param rgba Color tint as RGBA8.
+     */
+    void writeQuadVertices(SpriteVertex* out,
+                           float x, float y,
+                           float width, float height,
+                           float anchorX, float anchorY,
+                           float rotation,
+                           float u0, float v0, float u1, float v1,
+                           const uint8_t rgba[4]);
+
+    /**
+     * @class OpenGLSpriteBatch
+     * @brief Accumulates textured quads and draws them with as few calls as possible.
+     *
+     * Quads are written directly into a region reserved from a shared
+     * OpenGLStreamBuffer, so no intermediate copy is made.
+     *
+     * 2D textures are collected in a slot table of up to getMaxSlots()
+     * entries, bound to texture units 0..N-1 at flush time; each quad's
+     * vertices record the slot of their texture, so quads from different
+     * textures share a draw call. A slot is a texture plus the sampler
+     * object bound with it, so one texture drawn with two samplers takes
+     * two slots of the same draw. A draw call is only issued when:
+     *  - a new texture/sampler pair arrives and the slot table is full,
+     *  - the texture target changes, or the texture array or its sampler changes,
+     *  - the batch is full,
+     *  - or flush() is called explicitly.
+     *
+     * The batch does not own a shader program. The caller is expected to
+     * bind a program compatible with SpriteVertex before flushing.
+     */
+    class OpenGLSpriteBatch {
+    public:
+        /** Number of vertices emitted per quad */
+        static constexpr std::size_t VerticesPerQuad = 4;
+
+        /** Number of indices emitted per quad */
+        static constexpr std::size_t IndicesPerQuad = 6;
+
+        /** Upper bound of the texture slot table (texture units shadowed by the state cache) */
+        static constexpr std::size_t MaxSlots = 32;
+
+        /**
+         * @brief Constructs an empty batch.
+         *
+         * No OpenGL resources are created until init() is called.
+         *
+         * @param maxQuads Maximum number of quads per draw call.
+         */
+        explicit OpenGLSpriteBatch(std::size_t maxQuads = 8192);
+
+        /**
+         * @brief Destroys the batch and releases OpenGL resources.
+         */
+        ~OpenGLSpriteBatch();
+
+        OpenGLSpriteBatch(const OpenGLSpriteBatch&) = delete;
+        OpenGLSpriteBatch& operator=(const OpenGLSpriteBatch&) = delete;
+
+        /**
+         * @brief Creates the VAO and static index buffer.
+         *
+         * Sizes the slot table from GL_MAX_TEXTURE_IMAGE_UNITS.
+         * Requires a current OpenGL context.
+         *
+         * @param stream Initialized ring buffer vertices are allocated from.
+         *               Must outlive the batch.
+         */
+        void init(OpenGLStreamBuffer& stream);
+
+        /**
+         * @brief Releases all OpenGL resources owned by the batch.
+         */
+        void shutdown();
+
+        /**
+         * @brief Reserves room for one quad drawn with the given texture.
+         *
+         * Flushes first if the texture cannot join the pending quads
+         * (slot table full, different target or texture array) or if the
+         * batch is full. The slot of the returned vertices is filled in
+         * by the batch; callers must not rely on it.
+         *
+         * @param textureId OpenGL texture object used by the quad.
+         * @param target Kind of texture object.
+         * @param samplerId Sampler object bound with the texture (0 = texture parameters).
+         * @return Pointer to VerticesPerQuad vertices to be filled by the caller.
+         */
+        SpriteVertex* allocateQuad(unsigned int textureId,
+                                   TextureTarget target = TextureTarget::Texture2D,
+                                   unsigned int samplerId = 0);
+
+        /**
+         * @brief Reserves room for several consecutive quads drawn with the given texture.
+         *
+         * Behaves like allocateQuad(), but may grant fewer quads than
+         * requested when the batch fills up; call again for the rest.
+         *
+         * @param textureId OpenGL texture object used by the quads.
+         * @param requested Number of quads wanted.
+         * @param granted Receives the number of quads actually reserved.
+         * @param target Kind of texture object.
+         * @param samplerId Sampler object bound with the texture (0 = texture parameters).
+         * @return Pointer to granted * VerticesPerQuad vertices.
+         */
+        SpriteVertex* allocateQuads(unsigned int textureId, std::size_t requested, std::size_t& granted,
+                                    TextureTarget target = TextureTarget::Texture2D,
+                                    unsigned int samplerId = 0);
+
+        /**
+         * @brief Uploads and draws all pending quads.
+         *
+         * Does nothing if the batch is empty.
+         */
+        void flush();
+
+        /**
+         * @brief Gets the texture target of the quads waiting to be drawn.
+         *
+         * Lets the caller bind a matching shader before flush().
+         */
+        TextureTarget getPendingTarget() const noexcept { return m_textureTarget; }
+
+        /**
+         * @brief Gets the number of texture slots a draw call can sample.
+         *
+         * Valid after init(); the sprite shader must declare this many samplers.
+         */
+        std::size_t getMaxSlots() const noexcept { return m_maxSlots; }
+
+        /**
+         * @brief Gets the number of quads waiting to be drawn.
+         */
+        std::size_t getPendingQuads() const noexcept { return m_quadCount; }
+
+        /**
+         * @brief Gets the number of draw calls issued since the last reset.
+         */
+        std::size_t getDrawCalls() const noexcept { return m_drawCalls; }
+
+        /**
+         * @brief Gets the number of quads drawn since the last reset.
+         */
+        std::size_t getDrawnQuads() const noexcept { return m_drawnQuads; }
+
+        /**
+         * @brief Resets the draw call and quad counters.
+         */
+        void resetCounters() noexcept { m_drawCalls = 0; m_drawnQuads = 0; }
+
+    private:
+        /**
+         * @brief Points the vertex attributes at a byte offset of the stream buffer.
+         *
+         * Only used when glDrawElementsBaseVertex is unavailable.
+         */
+        void setVertexLayout(std::size_t offset);
+
+        /**
+         * @brief Finds or adds the slot of a 2D texture and sampler pair.
+         *
+         * @return Slot index, or -1 if the table is full.
+         */
+        int acquireSlot(unsigned int textureId, unsigned int samplerId);
+
+        /**
+         * @brief Writes the current slot into the vertices reserved since the last stamp.
+         */
+        void stampSlots();
+
+        /** Maximum quads per draw */
+        std::size_t m_maxQuads;
+
+        /** Ring buffer vertices are allocated from (not owned) */
+        OpenGLStreamBuffer* m_stream = nullptr;
+
+        /** Region currently being filled */
+        OpenGLStreamBuffer::Allocation m_allocation;
+
+        /** Quads currently stored in m_allocation */
+        std::size_t m_quadCount = 0;
+
+        /** Texture array used by the pending quads (Texture2DArray only) */
+        unsigned int m_textureId = 0;
+
+        /** Sampler bound with the texture array */
+        unsigned int m_samplerId = 0;
+
+        /** Target of the pending quads */
+        TextureTarget m_textureTarget = TextureTarget::Texture2D;
+
+        /** 2D textures used by the pending quads, indexed by slot */
+        unsigned int m_slots[MaxSlots] = {};
+
+        /** Sampler objects bound with m_slots */
+        unsigned int m_slotSamplers[MaxSlots] = {};
+
+        /** Used entries of m_slots */
+        std::size_t m_slotCount = 0;
+
+        /** Size of the slot table */
+        std::size_t m_maxSlots = 1;
+
+        /** Slot of the most recently reserved quads */
+        uint16_t m_currentSlot = 0;
+
+        /** Pending quads whose slot has been written */
+        std::size_t m_stampedQuads = 0;
+
+        /** Vertex Array Object */
+        unsigned int m_VAO = 0;
+
+        /** Static index buffer */
+        unsigned int m_EBO = 0;
+
+        /** Whether glDrawElementsBaseVertex can be used */
+        bool m_baseVertex = false;
+
+        /** Whether sampler objects can be bound */
+        bool m_samplers = false;
+
+        /** Draw calls issued since last reset */
+        std::size_t m_drawCalls = 0;
+
+        /** Quads drawn since last reset */
+        std::size_t m_drawnQuads = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "retronomicon/graphics/opengl_shader_program.h"
+#include "retronomicon/graphics/opengl_stream_buffer.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::opengl::graphics::OpenGLShaderProgram;
+    using retronomicon::opengl::graphics::OpenGLStreamBuffer;
+
+    /**
+     * @struct SpriteInstance
+     * @brief Per-instance data consumed by the instanced sprite shader.
+     *
+     * The transform is expanded on the GPU, so the CPU only writes
+     * 48 bytes per sprite instead of four transformed vertices.
+     */
+    struct SpriteInstance {
+        /** World-space position of the anchor point */
+        float x = 0.0f, y = 0.0f;
+
+        /** Size in pixels */
+        float width = 0.0f, height = 0.0f;
+
+        /** Anchor as a fraction of the size */
+        float anchorX = 0.0f, anchorY = 0.0f;
+
+        /** Rotation around the anchor in degrees */
+        float rotation = 0.0f;
+
+        /** Top-left texture coordinate */
+        float uvOffsetX = 0.0f, uvOffsetY = 0.0f;
+
+        /** Texture coordinate extent */
+        float uvScaleX = 1.0f, uvScaleY = 1.0f;
+
+        /** Color tint as RGBA8, with the alpha multiplier folded into a */
+        uint8_t r = 255, g = 255, b = 255, a = 255;
+    };
+
+    /**
+     * @brief Expands an instance into four batch vertices on the CPU.
+     *
+     * Used where instancing is unavailable or unsuitable.
+     *
+     * @param out Destination for four vertices.
+     * @param instance Instance to expand.
+     */
+    void writeInstanceQuad(SpriteVertex* out, const SpriteInstance& instance);
+
+    /**
+     * @class OpenGLSpriteInstancer
+     * @brief Draws many same-texture sprites with one instanced draw call.
+     *
+     * A static unit quad is used as the base mesh, and per-instance data
+     * is streamed through a shared OpenGLStreamBuffer with an attribute
+     * divisor of 1.
+     *
+     * Requires GL_ARB_draw_instanced and GL_ARB_instanced_arrays; use
+     * isSupported() to check before drawing.
+     */
+    class OpenGLSpriteInstancer {
+    public:
+        /**
+         * @brief Constructs an instancer.
+         *
+         * @param maxInstances Maximum instances uploaded per draw call.
+         */
+        explicit OpenGLSpriteInstancer(std::size_t maxInstances = 16384);
+
+        /**
+         * @brief Destroys the instancer and releases OpenGL resources.
+         */
+        ~OpenGLSpriteInstancer();
+
+        OpenGLSpriteInstancer(const OpenGLSpriteInstancer&) = delete;
+        OpenGLSpriteInstancer& operator=(const OpenGLSpriteInstancer&) = delete;
+
+        /**
+         * @brief Checks whether the driver supports instanced arrays.
+         *
+         * Requires a current OpenGL context.
+         */
+        static bool isSupported();
+
+        /**
+         * @brief Compiles the instanced shader and creates the buffers.
+         *
+         * @param projection Column-major 4x4 projection matrix.
+         * @param stream Initialized ring buffer instance data is allocated from.
+         *               Must outlive the instancer.
+         */
+        void init(const float* projection, OpenGLStreamBuffer& stream);
+
+        /**
+         * @brief Releases all OpenGL resources.
+         */
+        void shutdown();
+
+        /**
+         * @brief Draws instances of the unit quad with the given texture.
+         *
+         * Issues one draw call per maxInstances instances.
+         *
+         * @param textureId OpenGL texture bound to unit 0.
+         * @param instances Instance array.
+         * @param count Number of instances.
+         * @param samplerId Sampler object bound to unit 0 (0 = texture parameters).
+         */
+        void draw(unsigned int textureId, const SpriteInstance* instances, std::size_t count,
+                  unsigned int samplerId = 0);
+
+        /**
+         * @brief Gets the number of draw calls issued since the last reset.
+         */
+        std::size_t getDrawCalls() const noexcept { return m_drawCalls; }
+
+        /**
+         * @brief Gets the number of instances drawn since the last reset.
+         */
+        std::size_t getDrawnInstances() const noexcept { return m_drawnInstances; }
+
+        /**
+         * @brief Resets the draw call and instance counters.
+         */
+        void resetCounters() noexcept { m_drawCalls = 0; m_drawnInstances = 0; }
+
+    private:
+        /**
+         * @brief Points the per-instance attributes at a byte offset of the stream buffer.
+         */
+        void setInstanceLayout(std::size_t offset);
+
+        /** Maximum instances per draw */
+        std::size_t m_maxInstances;
+
+        /** Ring buffer instance data is allocated from (not owned) */
+        OpenGLStreamBuffer* m_stream = nullptr;
+
+        /** Instanced sprite shader */
+        OpenGLShaderProgram m_shader;
+
+        /** Vertex Array Object */
+        unsigned int m_VAO = 0;
+
+        /** Static unit quad (triangle strip) */
+        unsigned int m_quadVBO = 0;
+
+        /** Draw calls issued since last reset */
+        std::size_t m_drawCalls = 0;
+
+        /** Instances drawn since last reset */
+        std::size_t m_drawnInstances = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics::renderer
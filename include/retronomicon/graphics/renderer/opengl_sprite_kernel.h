@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    /**
+     * @struct SpriteArrays
+     * @brief Structure-of-arrays view over a set of sprites.
+     *
+     * Every array must hold at least as many elements as the count passed
+     * to the kernel. The arrays are only read, never owned.
+     */
+    struct SpriteArrays {
+        /** World-space anchor position */
+        const float* x = nullptr;
+        const float* y = nullptr;
+
+        /** Size in pixels */
+        const float* width = nullptr;
+        const float* height = nullptr;
+
+        /** Anchor as a fraction of the size */
+        const float* anchorX = nullptr;
+        const float* anchorY = nullptr;
+
+        /** Rotation around the anchor in degrees */
+        const float* rotation = nullptr;
+
+        /** Normalized UV rectangle (top-left / bottom-right) */
+        const float* u0 = nullptr;
+        const float* v0 = nullptr;
+        const float* u1 = nullptr;
+        const float* v1 = nullptr;
+
+        /** Packed RGBA8 tint (byte order r, g, b, a); nullptr means opaque white */
+        const uint32_t* color = nullptr;
+    };
+
+    /**
+     * @brief Generates quad vertices for many sprites at once.
+     *
+     * Computes the same 2D affine transform as writeQuadVertices(), but
+     * several sprites per iteration using the widest SIMD instruction set
+     * enabled at compile time (AVX2, then SSE2, then scalar).
+     *
+     * @param sprites Input arrays.
+     * @param count Number of sprites.
+     * @param out Destination for count * 4 vertices.
+     */
+    void buildSpriteVertices(const SpriteArrays& sprites, std::size_t count, SpriteVertex* out);
+
+    /**
+     * @brief Scalar reference version of buildSpriteVertices().
+     *
+     * Always available; used for the tail of SIMD loops and for validation.
+     */
+    void buildSpriteVerticesScalar(const SpriteArrays& sprites, std::size_t count, SpriteVertex* out);
+
+    /**
+     * @brief Gets the name of the instruction set used by buildSpriteVertices().
+     *
+     * @return "AVX2", "SSE2" or "scalar".
+     */
+    const char* getSpriteKernelIsa();
+
+} // namespace retronomicon::opengl::graphics::renderer
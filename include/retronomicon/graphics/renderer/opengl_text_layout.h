@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "retronomicon/asset/opengl_font_asset.h"
+#include "retronomicon/graphics/opengl_glyph_cache.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::opengl::asset::OpenGLFontAsset;
+    using retronomicon::opengl::graphics::OpenGLGlyphCache;
+
+    /**
+     * @struct TextExtent
+     * @brief Size of a laid out block of text, in pixels.
+     */
+    struct TextExtent {
+        /** Width of the widest line */
+        float width = 0.0f;
+
+        /** Height of all lines, from the top of the first to the bottom of the last */
+        float height = 0.0f;
+    };
+
+    /**
+     * @brief Lays out a string into glyph quads sampling the font atlas.
+     *
+     * The pen starts at the top-left corner (@p x, @p y); the first
+     * baseline sits one ascent below it. Each glyph is placed at its
+     * bearing from the pen and moves it by its advance. '\n' starts a new
+     * line one line height (ascent - descent + line gap) lower and '\t'
+     * advances to the next multiple of four spaces. Characters missing
+     * from the font are skipped, and glyphs without pixels (spaces) only
+     * advance the pen.
+     *
+     * UVs are relative to the atlas texture, ready for remapVertices().
+     *
+     * @param font Loaded font providing glyph metrics and atlas UVs.
+     * @param text Text to lay out.
+     * @param x Left edge of the block.
+     * @param y Top edge of the block.
+     * @param scale Size multiplier applied to all metrics.
+     * @param rgba Color tint as RGBA8.
+     * @param out Receives four vertices per visible glyph (appended).
+     * @return Number of quads appended.
+     */
+    std::size_t layoutText(const OpenGLFontAsset& font,
+                           std::string_view text,
+                           float x, float y,
+                           float scale,
+                           const uint8_t rgba[4],
+                           std::vector<SpriteVertex>& out);
+
+    /**
+     * @brief Measures a string as layoutText() would place it.
+     *
+     * @param font Loaded font.
+     * @param text Text to measure.
+     * @param scale Size multiplier applied to all metrics.
+     */
+    TextExtent measureText(const OpenGLFontAsset& font, std::string_view text, float scale = 1.0f);
+
+    /**
+     * @brief Lays out a UTF-8 string with glyphs from a glyph cache.
+     *
+     * Same placement rules as the font atlas overload. Missing glyphs are
+     * rasterized on the way, so this must run on the GL thread. Glyphs
+     * can land on different cache pages; UVs are relative to their page.
+     *
+     * @param pages Receives the cache page of each appended quad (appended).
+     * @return Number of quads appended.
+     */
+    std::size_t layoutText(OpenGLGlyphCache& cache,
+                           std::string_view utf8,
+                           float x, float y,
+                           float scale,
+                           const uint8_t rgba[4],
+                           std::vector<SpriteVertex>& out,
+                           std::vector<uint16_t>& pages);
+
+    /**
+     * @brief Measures a UTF-8 string as the glyph cache overload of layoutText() would place it.
+     */
+    TextExtent measureText(OpenGLGlyphCache& cache, std::string_view utf8, float scale = 1.0f);
+
+    /**
+     * @brief Decodes the UTF-8 sequence starting at @p pos and moves past it.
+     *
+     * @return Codepoint, or U+FFFD for a malformed sequence (one byte is skipped).
+     */
+    uint32_t decodeUtf8(std::string_view text, std::size_t& pos) noexcept;
+
+} // namespace retronomicon::opengl::graphics::renderer
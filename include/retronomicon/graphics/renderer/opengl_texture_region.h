@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "retronomicon/graphics/texture.h"
+#include "retronomicon/graphics/renderer/opengl_render_queue.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_instancer.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::graphics::Texture;
+
+    /**
+     * @struct TextureRegion
+     * @brief GL texture object and UV rectangle a Texture draws from.
+     *
+     * A plain OpenGLTexture covers its whole texture object, an atlas
+     * sub-texture covers only part of its page, and a pooled array texture
+     * is one layer of a GL_TEXTURE_2D_ARRAY. Draw paths work in
+     * texture-relative UVs and map them through the region.
+     */
+    struct TextureRegion {
+        /** OpenGL texture object to bind */
+        unsigned int textureId = 0;
+
+        /** Kind of texture object */
+        TextureTarget target = TextureTarget::Texture2D;
+
+        /** Array layer (Texture2DArray only) */
+        uint16_t layer = 0;
+
+        /** UV rectangle inside the texture object */
+        float u0 = 0.0f, v0 = 0.0f;
+        float u1 = 1.0f, v1 = 1.0f;
+
+        /**
+         * @brief Checks whether the region spans the whole texture object.
+         */
+        bool isFull() const noexcept {
+            return u0 == 0.0f && v0 == 0.0f && u1 == 1.0f && v1 == 1.0f;
+        }
+
+        /**
+         * @brief Maps a texture-relative UV into the texture object.
+         */
+        float mapU(float u) const noexcept { return u0 + u * (u1 - u0); }
+        float mapV(float v) const noexcept { return v0 + v * (v1 - v0); }
+    };
+
+    /**
+     * @brief Resolves an engine texture into the GL texture and UV rect to draw from.
+     *
+     * Accepts OpenGLTexture, OpenGLSubTexture and OpenGLArrayTexture, and
+     * stamps the texture as used this frame. On the render thread an
+     * evicted texture is re-uploaded first. Off the render thread the GL
+     * texture object may change under the caller (eviction, array pool
+     * growth), so only UVs, target and layer are filled in and textureId
+     * is left 0; OpenGLRenderQueue::append() resolves it on submission.
+     *
+     * @param texture Texture to resolve.
+     * @param out Receives the region.
+     * @param renderThread Whether GL calls are allowed (render thread).
+     * @return false if the texture is not backed by OpenGL.
+     */
+    bool resolveTextureRegion(Texture* texture, TextureRegion& out, bool renderThread = false);
+
+    /**
+     * @brief Gets the render queue shader slot for quads drawn from a region.
+     */
+    inline uint32_t quadShaderSlot(const TextureRegion& region) noexcept {
+        switch (region.target) {
+            case TextureTarget::Texture2DArray: return OpenGLRenderQueue::ShaderSpriteArray;
+            case TextureTarget::DistanceField:  return OpenGLRenderQueue::ShaderDistanceField;
+            default:                            return OpenGLRenderQueue::ShaderSprite;
+        }
+    }
+
+    /**
+     * @brief Gets the batch texture target for quads recorded with a queue shader slot.
+     */
+    inline TextureTarget quadTextureTarget(uint32_t shaderSlot) noexcept {
+        switch (shaderSlot) {
+            case OpenGLRenderQueue::ShaderSpriteArray:   return TextureTarget::Texture2DArray;
+            case OpenGLRenderQueue::ShaderDistanceField: return TextureTarget::DistanceField;
+            default:                                     return TextureTarget::Texture2D;
+        }
+    }
+
+    /**
+     * @brief Maps the UVs of already generated vertices into a region and sets their layer.
+     */
+    void remapVertices(const TextureRegion& region, SpriteVertex* vertices, std::size_t count);
+
+    /**
+     * @brief Maps the UV rectangles of instances into a region.
+     */
+    void remapInstances(const TextureRegion& region, SpriteInstance* instances, std::size_t count);
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "retronomicon/graphics/texture.h"
+#include "retronomicon/graphics/spatial_grid.h"
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+#include "retronomicon/graphics/renderer/opengl_texture_region.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+    using retronomicon::graphics::Texture;
+    using retronomicon::opengl::graphics::Bounds2D;
+
+    /**
+     * @class OpenGLTilemap
+     * @brief Tile layer drawn from static, per-chunk vertex buffers.
+     *
+     * The map is split into chunks of getChunkSize() x getChunkSize()
+     * tiles. Each chunk is baked once into its own VBO of SpriteVertex
+     * quads (empty tiles are skipped) and drawn with a single
+     * glDrawElements call. setTile() only marks the chunk holding the tile
+     * dirty; dirty chunks are rebuilt the next time they are drawn, so
+     * edits to off-screen chunks cost nothing until they come into view.
+     *
+     * Tiles are indices into a tileset texture read left to right, top
+     * to bottom. Any texture the renderer accepts can be a tileset,
+     * including atlas sub-textures and texture array layers.
+     *
+     * Drawn through OpenGLRenderer::renderTilemap(), which supplies the
+     * sprite shader. All methods touching GPU resources must run on the
+     * thread owning the context.
+     */
+    class OpenGLTilemap {
+    public:
+        /** Tile index of an empty cell */
+        static constexpr int EmptyTile = -1;
+
+        /** Largest chunk size addressable with 16-bit indices */
+        static constexpr int MaxChunkSize = 128;
+
+        /**
+         * @brief Creates an empty map; no GPU resources are created yet.
+         *
+         * @param width Map width in tiles.
+         * @param height Map height in tiles.
+         * @param tileWidth Tile width in pixels, in the tileset and on screen.
+         * @param tileHeight Tile height in pixels.
+         * @param chunkSize Tiles per chunk side (clamped to 1..MaxChunkSize).
+         */
+        OpenGLTilemap(int width, int height, int tileWidth, int tileHeight, int chunkSize = 32);
+
+        /**
+         * @brief Releases the chunk buffers.
+         */
+        ~OpenGLTilemap();
+
+        OpenGLTilemap(const OpenGLTilemap&) = delete;
+        OpenGLTilemap& operator=(const OpenGLTilemap&) = delete;
+
+        /**
+         * @brief Sets the texture tiles are read from and marks every chunk dirty.
+         *
+         * @param tileset Tileset texture.
+         * @param spacing Pixels between adjacent tiles in the tileset.
+         * @param margin Pixels around the tile grid in the tileset.
+         */
+        void setTileset(std::shared_ptr<Texture> tileset, int spacing = 0, int margin = 0);
+
+        /**
+         * @brief Gets the tileset texture.
+         */
+        const std::shared_ptr<Texture>& getTileset() const noexcept { return m_tileset; }
+
+        /**
+         * @brief Sets the tile of a cell and marks its chunk dirty if it changed.
+         *
+         * Out-of-range cells are ignored.
+         *
+         * @param x Column.
+         * @param y Row.
+         * @param tile Tileset index, or EmptyTile.
+         */
+        void setTile(int x, int y, int tile);
+
+        /**
+         * @brief Gets the tile of a cell.
+         *
+         * @return Tileset index, or EmptyTile for empty or out-of-range cells.
+         */
+        int getTile(int x, int y) const;
+
+        /**
+         * @brief Sets every cell and marks every chunk dirty.
+         */
+        void fill(int tile);
+
+        /**
+         * @brief Sets the world position of the top-left corner of cell (0, 0).
+         *
+         * Vertices are baked in world space, so moving the map rebuilds
+         * every chunk.
+         */
+        void setOrigin(float x, float y);
+
+        /**
+         * @brief Gets the world-space bounds of the whole map.
+         */
+        Bounds2D getBounds() const noexcept;
+
+        /**
+         * @brief Resolves the tileset into the GL texture to bind.
+         *
+         * Marks every chunk dirty if the tileset's UV rectangle changed.
+         *
+         * @return false if there is no tileset or it is not an OpenGL texture.
+         */
+        bool resolveTileset(TextureRegion& out);
+
+        /**
+         * @brief Draws the chunks overlapping a view.
+         *
+         * Rebuilds dirty visible chunks first. The caller binds a sprite
+         * shader matching the tileset's texture target and the tileset
+         * on texture unit 0.
+         *
+         * @param view World-space area to draw.
+         * @param region Tileset region returned by resolveTileset().
+         * @return Number of tile quads drawn.
+         */
+        std::size_t draw(const Bounds2D& view, const TextureRegion& region);
+
+        /**
+         * @brief Frees the chunk buffers; they are recreated on the next draw.
+         */
+        void release();
+
+        /**
+         * @brief Gets the map width in tiles.
+         */
+        int getWidth() const noexcept { return m_width; }
+
+        /**
+         * @brief Gets the map height in tiles.
+         */
+        int getHeight() const noexcept { return m_height; }
+
+        /**
+         * @brief Gets the number of tiles per chunk side.
+         */
+        int getChunkSize() const noexcept { return m_chunkSize; }
+
+        /**
+         * @brief Gets the total number of chunks.
+         */
+        std::size_t getChunkCount() const noexcept { return m_chunks.size(); }
+
+        /**
+         * @brief Gets the number of chunks drawn by the last draw().
+         */
+        std::size_t getDrawnChunks() const noexcept { return m_drawnChunks; }
+
+        /**
+         * @brief Gets the number of chunk rebuilds since creation.
+         */
+        std::size_t getRebuildCount() const noexcept { return m_rebuilds; }
+
+    private:
+        /** GPU geometry of a chunk */
+        struct Chunk {
+            unsigned int vao = 0;
+            unsigned int vbo = 0;
+
+            /** Bytes allocated in vbo */
+            std::size_t capacity = 0;
+
+            /** Non-empty tiles baked into vbo */
+            std::size_t quadCount = 0;
+
+            bool dirty = true;
+        };
+
+        /**
+         * @brief Bakes the tiles of a chunk into its VBO.
+         */
+        void rebuild(std::size_t index, const TextureRegion& region);
+
+        /**
+         * @brief Creates the shared index buffer sized for a full chunk.
+         *
+         * Binds it to the currently bound VAO.
+         */
+        void createIndexBuffer();
+
+        void markAllDirty();
+
+        int m_width;
+        int m_height;
+        int m_tileWidth;
+        int m_tileHeight;
+        int m_chunkSize;
+        int m_chunksX;
+        int m_chunksY;
+
+        float m_originX = 0.0f;
+        float m_originY = 0.0f;
+
+        /** Row-major tile indices */
+        std::vector<int> m_tiles;
+
+        std::vector<Chunk> m_chunks;
+
+        std::shared_ptr<Texture> m_tileset;
+        int m_spacing = 0;
+        int m_margin = 0;
+
+        /** Region the baked UVs were mapped into */
+        TextureRegion m_bakedRegion;
+
+        /** Tileset size the baked UVs were computed from */
+        int m_bakedWidth = 0;
+        int m_bakedHeight = 0;
+
+        /** Index buffer shared by every chunk VAO */
+        unsigned int m_EBO = 0;
+
+        /** Vertices of the chunk being rebuilt */
+        std::vector<SpriteVertex> m_scratch;
+
+        std::size_t m_drawnChunks = 0;
+        std::size_t m_rebuilds = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics::renderer
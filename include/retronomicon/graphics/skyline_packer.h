@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @struct PackedRect
+     * @brief Position and size of a rectangle placed by a packer.
+     */
+    struct PackedRect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @class SkylinePacker
+     * @brief Online rectangle packer using the skyline bottom-left heuristic.
+     *
+     * The packed area is described by its "skyline": a list of horizontal
+     * segments marking the top of the occupied region. Each rectangle is
+     * placed where its top edge ends lowest, ties broken by the least
+     * wasted area underneath. Rectangles can be added one at a time,
+     * which suits atlases filled while assets load.
+     *
+     * The packer only computes positions; it owns no pixels.
+     */
+    class SkylinePacker {
+    public:
+        /**
+         * @brief Constructs a packer for an empty bin.
+         *
+         * @param width Bin width in pixels.
+         * @param height Bin height in pixels.
+         */
+        SkylinePacker(int width = 0, int height = 0);
+
+        /**
+         * @brief Empties the bin, optionally changing its size.
+         */
+        void reset(int width, int height);
+
+        /**
+         * @brief Places a rectangle.
+         *
+         * @param width Rectangle width.
+         * @param height Rectangle height.
+         * @param out Receives the placement on success.
+         * @return false if the rectangle does not fit anywhere.
+         */
+        bool insert(int width, int height, PackedRect& out);
+
+        /**
+         * @brief Gets the bin width.
+         */
+        int getWidth() const noexcept { return m_width; }
+
+        /**
+         * @brief Gets the bin height.
+         */
+        int getHeight() const noexcept { return m_height; }
+
+        /**
+         * @brief Gets the total area of placed rectangles.
+         */
+        std::size_t getUsedArea() const noexcept { return m_usedArea; }
+
+        /**
+         * @brief Gets the fraction of the bin covered by placed rectangles.
+         *
+         * @return Occupancy in [0, 1].
+         */
+        float getOccupancy() const noexcept;
+
+    private:
+        /** Horizontal segment of the skyline */
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        /**
+         * @brief Computes the Y a rectangle would rest at if placed on a segment.
+         *
+         * @return Resting Y, or -1 if it does not fit; wasted receives the
+         *         area left empty underneath.
+         */
+        int fit(std::size_t index, int width, int height, long long& wasted) const;
+
+        int m_width;
+        int m_height;
+        std::size_t m_usedArea = 0;
+        std::vector<Segment> m_skyline;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace retronomicon::opengl::graphics {
+
+    /**
+     * @struct Bounds2D
+     * @brief Axis-aligned bounding box in world space.
+     */
+    struct Bounds2D {
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = 0.0f;
+        float maxY = 0.0f;
+
+        /**
+         * @brief Checks whether two boxes overlap (touching edges do not count).
+         */
+        bool intersects(const Bounds2D& other) const noexcept {
+            return minX < other.maxX && other.minX < maxX &&
+                   minY < other.maxY && other.minY < maxY;
+        }
+
+        /**
+         * @brief Computes the box enclosing a rotated, anchored quad.
+         *
+         * Takes the same parameters as writeQuadVertices().
+         *
+         * @param x World-space X of the anchor point.
+         * @param y World-space Y of the anchor point.
+         * @param width Quad width.
+         * @param height Quad height.
+         * @param anchorX Anchor as a fraction of the width.
+         * @param anchorY Anchor as a fraction of the height.
+         * @param rotation Rotation around the anchor in degrees.
+         */
+        static Bounds2D fromQuad(float x, float y, float width, float height,
+                                 float anchorX, float anchorY, float rotation) noexcept;
+    };
+
+    /**
+     * @class SpatialGrid
+     * @brief Uniform grid of retained objects for visibility queries.
+     *
+     * Each object is registered with its bounding box and a caller-chosen
+     * value (an entity or sprite index) and is stored in every cell its
+     * box overlaps. Cells are kept in a hash map, so only occupied cells
+     * cost memory and the world has no fixed extent.
+     *
+     * query() visits only the cells overlapping the view, which keeps the
+     * cost proportional to what is on screen rather than to the world
+     * size. Objects spanning several cells are reported once.
+     *
+     * Pick a cell size around a few times the typical object size: much
+     * smaller cells store large objects many times, much larger ones test
+     * many off-screen objects.
+     */
+    class SpatialGrid {
+    public:
+        /** Identifies an object inside the grid */
+        using Handle = uint32_t;
+
+        /** Returned by insert() for an empty box */
+        static constexpr Handle InvalidHandle = 0xFFFFFFFFu;
+
+        /**
+         * @brief Constructs an empty grid.
+         *
+         * @param cellSize Cell width and height in world units.
+         */
+        explicit SpatialGrid(float cellSize = 256.0f);
+
+        /**
+         * @brief Adds an object.
+         *
+         * @param bounds Object bounds.
+         * @param value Value reported by query().
+         * @return Handle used to move or remove the object.
+         */
+        Handle insert(const Bounds2D& bounds, uint32_t value);
+
+        /**
+         * @brief Moves an object; cells are only touched if it changed cells.
+         */
+        void update(Handle handle, const Bounds2D& bounds);
+
+        /**
+         * @brief Removes an object. Its handle may be reused by later inserts.
+         */
+        void remove(Handle handle);
+
+        /**
+         * @brief Collects the values of the objects overlapping a view.
+         *
+         * Values are appended to @p out in no particular order; callers
+         * needing a draw order sort them afterwards. Not thread-safe, as
+         * the grid stamps visited objects.
+         *
+         * @param view Visible area, typically OpenGLRenderer::getViewBounds().
+         * @param out Receives the values of visible objects.
+         * @return Number of values appended.
+         */
+        std::size_t query(const Bounds2D& view, std::vector<uint32_t>& out);
+
+        /**
+         * @brief Removes every object and cell.
+         */
+        void clear();
+
+        /**
+         * @brief Gets the number of objects in the grid.
+         */
+        std::size_t size() const noexcept { return m_items.size() - m_free.size(); }
+
+        /**
+         * @brief Gets the number of cells holding at least one object.
+         */
+        std::size_t getCellCount() const noexcept { return m_cells.size(); }
+
+        /**
+         * @brief Gets the cell size in world units.
+         */
+        float getCellSize() const noexcept { return m_cellSize; }
+
+    private:
+        /** Inclusive range of cells covered by a box */
+        struct CellRange {
+            int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+
+            bool operator==(const CellRange& other) const noexcept {
+                return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+            }
+        };
+
+        struct Item {
+            Bounds2D bounds;
+            uint32_t value = 0;
+            CellRange cells;
+
+            /** Query that last reported the item */
+            uint32_t stamp = 0;
+            bool alive = false;
+        };
+
+        CellRange getCells(const Bounds2D& bounds) const noexcept;
+
+        static uint64_t cellKey(int x, int y) noexcept {
+            return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+        }
+
+        void link(Handle handle);
+        void unlink(Handle handle);
+
+        float m_cellSize;
+        float m_invCellSize;
+
+        std::vector<Item> m_items;
+
+        /** Handles of removed items, reused first */
+        std::vector<Handle> m_free;
+
+        /** cellKey() -> handles of the items overlapping the cell */
+        std::unordered_map<uint64_t, std::vector<Handle>> m_cells;
+
+        uint32_t m_queryStamp = 0;
+    };
+
+} // namespace retronomicon::opengl::graphics
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "retronomicon/graphics/texture.h"
 #include "retronomicon/manager/texture_manager.h"
 #include "retronomicon/asset/image_asset.h"
 #include "retronomicon/asset/font_asset.h"
+#include "retronomicon/graphics/opengl_texture_atlas.h"
+#include "retronomicon/graphics/opengl_texture_array_pool.h"
+#include "retronomicon/graphics/opengl_texture_uploader.h"
 
 namespace retronomicon::opengl::manager {
 
@@ -13,15 +20,326 @@ namespace retronomicon::opengl::manager {
     using retronomicon::graphics::Texture;
     using retronomicon::asset::ImageAsset;
     using retronomicon::asset::FontAsset;
+    using retronomicon::opengl::graphics::OpenGLTextureAtlas;
+    using retronomicon::opengl::graphics::OpenGLTextureArrayPool;
+    using retronomicon::opengl::graphics::OpenGLTextureUploader;
+    using retronomicon::opengl::graphics::OpenGLTexture;
+    using retronomicon::opengl::graphics::TextureDesc;
+    using retronomicon::opengl::graphics::TextureFilter;
+
+    /**
+     * @struct TextureMemoryStats
+     * @brief GPU memory accounting of the textures created by OpenGLTextureManager.
+     */
+    struct TextureMemoryStats {
+        /** Configured budget in bytes (0 = unlimited) */
+        std::size_t budgetBytes = 0;
+
+        /** Estimated bytes of resident textures */
+        std::size_t residentBytes = 0;
+
+        /** Textures currently on the GPU */
+        std::size_t residentTextures = 0;
+
+        /** Textures currently evicted */
+        std::size_t evictedTextures = 0;
+
+        /** Evictions performed since the manager was created */
+        std::size_t evictions = 0;
+
+        /** Re-uploads after eviction, summed over live textures */
+        std::size_t restores = 0;
+    };
+
+    /**
+     * @struct TextureCacheStats
+     * @brief Effectiveness of the OpenGLTextureManager texture cache.
+     */
+    struct TextureCacheStats {
+        /** Requests served by an existing texture */
+        std::size_t hits = 0;
+
+        /** Of which matched by pixel content rather than asset identity */
+        std::size_t contentHits = 0;
+
+        /** Requests that created a texture */
+        std::size_t misses = 0;
+
+        /** Upload bytes avoided by hits */
+        std::size_t bytesSaved = 0;
+
+        /** Cache entries, live or not yet swept */
+        std::size_t entries = 0;
+    };
 
     class OpenGLTextureManager : public TextureManager {
     public:
         OpenGLTextureManager();
 
+        /**
+         * @brief Creates a texture for an image with the default descriptor.
+         *
+         * In atlas mode the image is packed into a shared atlas page and an
+         * OpenGLSubTexture is returned; images too large for a page still
+         * get their own OpenGLTexture.
+         */
         std::shared_ptr<Texture> createTexture(std::shared_ptr<ImageAsset> imageAsset) override;
 
+        /**
+         * @brief Creates a texture for an image with explicit storage and sampling options.
+         *
+         * The atlas is only used when @p desc matches its pages (no mips,
+         * clamped edges, same filter); other images get their own texture.
+         */
+        std::shared_ptr<Texture> createTexture(std::shared_ptr<ImageAsset> imageAsset, const TextureDesc& desc);
+
         // NEW OVERLOAD FOR FONT ASSET
         std::shared_ptr<Texture> createTexture(std::shared_ptr<FontAsset> fontAsset) override;
+
+        /**
+         * @brief Enables atlas-building mode for subsequently created image textures.
+         *
+         * Images created while the mode is on share large pages, so sprites
+         * from different images can be drawn in a single batch.
+         *
+         * @param pageSize Width and height of each atlas page in pixels.
+         * @param padding Border of replicated edge pixels around each image.
+         * @param filter Sampling filter of the pages.
+         */
+        void enableAtlas(int pageSize = 2048, int padding = 1, TextureFilter filter = TextureFilter::Linear);
+
+        /**
+         * @brief Disables atlas-building mode.
+         *
+         * Existing sub-textures stay valid; their pages are kept alive by them.
+         */
+        void disableAtlas();
+
+        /**
+         * @brief Checks whether atlas-building mode is on.
+         */
+        bool isAtlasEnabled() const { return m_atlas != nullptr; }
+
+        /**
+         * @brief Gets the atlas in use, or nullptr when atlas mode is off.
+         */
+        const OpenGLTextureAtlas* getAtlas() const { return m_atlas.get(); }
+
+        /**
+         * @brief Creates a texture stored as a layer of a shared texture array.
+         *
+         * Images with the same size and channel count go into the same
+         * GL_TEXTURE_2D_ARRAY pool, so sprites using any of them batch
+         * together without atlas UV remapping or padding. Falls back to a
+         * regular OpenGLTexture if the pool cannot take the image.
+         */
+        std::shared_ptr<Texture> createPooledTexture(std::shared_ptr<ImageAsset> imageAsset);
+
+        /**
+         * @brief Gets the number of texture array pools created so far.
+         */
+        std::size_t getPoolCount() const { return m_pools.size(); }
+
+        /**
+         * @brief Creates a texture whose pixels are uploaded in the background.
+         *
+         * Returns immediately with a texture that draws as a placeholder;
+         * decoding runs on worker threads and the upload completes over
+         * later processUploads() calls. The workers are started on first use.
+         */
+        std::shared_ptr<Texture> createTextureAsync(std::shared_ptr<ImageAsset> imageAsset);
+
+        /**
+         * @brief Creates a texture uploaded in the background with explicit options.
+         */
+        std::shared_ptr<Texture> createTextureAsync(std::shared_ptr<ImageAsset> imageAsset, const TextureDesc& desc);
+
+        /**
+         * @brief Advances asynchronous uploads.
+         *
+         * Call once per frame on the render thread.
+         *
+         * @param byteBudget Maximum bytes staged for upload by this call.
+         */
+        void processUploads(std::size_t byteBudget = OpenGLTextureUploader::DefaultBudget);
+
+        /**
+         * @brief Gets the number of asynchronous textures not resident yet.
+         */
+        std::size_t getPendingUploads() const { return m_uploader ? m_uploader->getPendingCount() : 0; }
+
+        /**
+         * @brief Creates a texture from pre-compressed KTX2 files.
+         *
+         * Looks for "<basePath>.<format>.ktx2" variants (see
+         * getFormatName) in order of quality — bc7, bc3, bc1, etc2a, etc2 —
+         * and loads the first one the GPU samples natively. If none is
+         * supported, the first existing variant is decoded on the CPU, and
+         * "<basePath>.ktx2" is tried last.
+         *
+         * @param basePath Path without the format suffix and extension.
+         * @param desc Mip and sampling options; uses the files' mip levels by default.
+         * @return Texture, or nullptr if no variant could be loaded.
+         */
+        std::shared_ptr<Texture> createCompressedTexture(const std::string& basePath,
+                                                         const TextureDesc& desc = TextureDesc::precomputed());
+
+        /**
+         * @brief Sets the descriptor used by the overloads without one.
+         *
+         * Defaults to TextureDesc{}: a single level, linear filtering and
+         * clamped edges. Font atlases always use the default descriptor.
+         */
+        void setDefaultTextureDesc(const TextureDesc& desc) { m_defaultDesc = desc; }
+
+        /**
+         * @brief Gets the descriptor used by the overloads without one.
+         */
+        const TextureDesc& getDefaultTextureDesc() const { return m_defaultDesc; }
+
+        /**
+         * @brief Sets the GPU memory budget for textures created by this manager.
+         *
+         * When the estimated size of resident textures exceeds the budget,
+         * updateResidency() evicts the least recently used ones that were
+         * created from an ImageAsset. Evicted textures are re-uploaded from
+         * their image the next time they are drawn or bound.
+         *
+         * @param bytes Budget in bytes; 0 disables eviction.
+         */
+        void setVramBudget(std::size_t bytes) { m_budget = bytes; }
+
+        /**
+         * @brief Gets the GPU memory budget (0 = unlimited).
+         */
+        std::size_t getVramBudget() const { return m_budget; }
+
+        /**
+         * @brief Restores flagged textures and evicts cold ones down to the budget.
+         *
+         * Call once per frame on the render thread, after drawing.
+         * Textures used in the current or previous frame are never evicted.
+         */
+        void updateResidency();
+
+        /**
+         * @brief Gets GPU memory statistics.
+         */
+        TextureMemoryStats getMemoryStats() const;
+
+        /**
+         * @brief Enables or disables texture deduplication (on by default).
+         *
+         * While enabled, the create functions first look for a live
+         * texture made from the same asset (by path, or name when the path
+         * is empty) and then from identical pixels (64-bit content hash),
+         * and return it instead of uploading again. The cache only holds
+         * weak references, so unused textures are still freed.
+         */
+        void setCacheEnabled(bool enabled) { m_cacheEnabled = enabled; }
+
+        /**
+         * @brief Checks whether texture deduplication is enabled.
+         */
+        bool isCacheEnabled() const { return m_cacheEnabled; }
+
+        /**
+         * @brief Gets texture cache counters.
+         */
+        TextureCacheStats getCacheStats() const;
+
+        /**
+         * @brief Forgets all cache entries; existing textures stay valid.
+         */
+        void clearCache();
+
+    private:
+        /**
+         * @brief Starts residency tracking for a texture.
+         */
+        void track(const std::shared_ptr<OpenGLTexture>& texture);
+
+        /** Identity of a texture request */
+        struct CacheKey {
+            /** Kind prefix plus asset path or name; empty if the asset has neither */
+            std::string identity;
+
+            /** Kind and pixel content hash; 0 if no pixels are available */
+            uint64_t content = 0;
+
+            /** Shape of the hashed pixels, compared on a content match */
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            std::size_t size = 0;
+
+            /** The hashed pixels, owned by their asset */
+            std::shared_ptr<const std::vector<uint8_t>> pixels;
+
+            /** Bytes an upload would cost */
+            std::size_t bytes = 0;
+        };
+
+        /** Content cache entry; shape and pixels guard against hash collisions */
+        struct ContentEntry {
+            std::weak_ptr<Texture> texture;
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            std::size_t size = 0;
+            std::weak_ptr<const std::vector<uint8_t>> pixels;
+        };
+
+        /**
+         * @brief Returns a live cached texture for the key, or nullptr.
+         *
+         * A content match only counts if the shape matches and the pixels
+         * compare equal to the ones the texture was created from; if that
+         * asset is gone the match cannot be verified and is a miss. A
+         * content match also registers the key's identity. Textures
+         * modified with OpenGLTexture::update() are dropped from the
+         * cache.
+         */
+        std::shared_ptr<Texture> findCached(const CacheKey& key);
+
+        /**
+         * @brief Records a newly created texture under the key.
+         */
+        void storeCached(const CacheKey& key, const std::shared_ptr<Texture>& texture);
+
+        /**
+         * @brief Removes entries whose texture has been released.
+         */
+        void sweepCache();
+
+        /** Descriptor of createTexture / createTextureAsync without one */
+        TextureDesc m_defaultDesc;
+
+        bool m_cacheEnabled = true;
+        std::unordered_map<std::string, std::weak_ptr<Texture>> m_cacheByIdentity;
+        std::unordered_map<uint64_t, ContentEntry> m_cacheByContent;
+        TextureCacheStats m_cacheStats;
+
+        /** Entry count that triggers the next sweep */
+        std::size_t m_sweepAt = 64;
+
+        /** Atlas used for image textures in atlas mode */
+        std::unique_ptr<OpenGLTextureAtlas> m_atlas;
+
+        /** Texture array pools keyed by width, height and channel count */
+        std::unordered_map<uint64_t, std::shared_ptr<OpenGLTextureArrayPool>> m_pools;
+
+        /** Background upload pipeline, created on first async request */
+        std::unique_ptr<OpenGLTextureUploader> m_uploader;
+
+        /** Textures subject to residency accounting */
+        std::vector<std::weak_ptr<OpenGLTexture>> m_tracked;
+
+        /** GPU memory budget in bytes (0 = unlimited) */
+        std::size_t m_budget = 0;
+
+        /** Evictions performed so far */
+        std::size_t m_evictions = 0;
     };
 
 } // namespace retronomicon::opengl::manager
@@ -1,12 +1,18 @@
 #include "retronomicon/asset/opengl_font_asset.h"
+#include "retronomicon/graphics/skyline_packer.h"
 #include <iostream>
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "stb_truetype.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <fstream> 
 
 namespace retronomicon::opengl::asset {
 
+using retronomicon::opengl::graphics::PackedRect;
+using retronomicon::opengl::graphics::SkylinePacker;
+
 bool OpenGLFontAsset::load() {
     if (m_isLoaded) return true;
 
@@ -46,9 +52,17 @@ void OpenGLFontAsset::unload() {
     m_pixels.shrink_to_fit();
     m_atlasWidth = 0;
     m_atlasHeight = 0;
+    m_packingEfficiency = 0.0f;
 
     m_glyphs.clear();
     m_bitmaps.clear();
+    m_fontInfo.reset();
+    m_fontData.clear();
+    m_fontData.shrink_to_fit();
+    m_scale = 0.0f;
+    m_ascent = 0;
+    m_descent = 0;
+    m_lineGap = 0;
 
     m_isLoaded = false;
 }
@@ -59,118 +73,241 @@ std::string OpenGLFontAsset::to_string() const {
            ", pointSize=" + std::to_string(m_pointSize) +
            ", atlas=" + std::to_string(m_atlasWidth) + "x" +
                         std::to_string(m_atlasHeight) +
+           (m_distanceField ? ", sdf=" + std::to_string(m_distanceSpread) : std::string()) +
            ")";
 }
 
 bool OpenGLFontAsset::loadGlyphs() {
-    std::vector<uint8_t> fontBuffer;
-    if (!loadFile(m_path, fontBuffer)) {
+    // stb_truetype reads straight from the file buffer, so it is kept
+    if (!loadFile(m_path, m_fontData)) {
         std::cerr << "[OpenGLFontAsset] Failed to read font file: " << m_path << "\n";
         return false;
     }
 
-    stbtt_fontinfo font;
-    if (!stbtt_InitFont(&font, fontBuffer.data(), 0)) {
+    auto font = std::make_shared<stbtt_fontinfo>();
+    if (!stbtt_InitFont(font.get(), m_fontData.data(), 0)) {
         std::cerr << "[OpenGLFontAsset] stbtt_InitFont failed\n";
         return false;
     }
+    m_fontInfo = std::move(font);
 
-    float scale = stbtt_ScaleForPixelHeight(&font, (float)m_pointSize);
+    m_scale = stbtt_ScaleForPixelHeight(m_fontInfo.get(), (float)m_pointSize);
 
     int ascent, descent, lineGap;
-    stbtt_GetFontVMetrics(&font, &ascent, &descent, &lineGap);
+    stbtt_GetFontVMetrics(m_fontInfo.get(), &ascent, &descent, &lineGap);
+    m_ascent  = int(std::lround(ascent * m_scale));
+    m_descent = int(std::lround(descent * m_scale));
+    m_lineGap = int(std::lround(lineGap * m_scale));
 
     m_glyphs.clear();
     m_bitmaps.clear();
 
     for (char c = 32; c < 127; ++c) {
-        int w, h, xoff, yoff;
+        GlyphBitmap bmp;
+        GlyphMetrics gm;
+        rasterizeGlyph(static_cast<uint32_t>(c), bmp, gm);
+
+        m_glyphs[c] = gm;
+        if (!bmp.pixels.empty())
+            m_bitmaps[c] = std::move(bmp);
+    }
+
+    return true;
+}
+
+bool OpenGLFontAsset::hasGlyph(uint32_t codepoint) const {
+    return m_fontInfo && stbtt_FindGlyphIndex(m_fontInfo.get(), static_cast<int>(codepoint)) != 0;
+}
 
-        unsigned char* bitmap = stbtt_GetCodepointBitmap(
-            &font,
+bool OpenGLFontAsset::rasterizeGlyph(uint32_t codepoint, GlyphBitmap& bmp, GlyphMetrics& gm) const {
+    if (!m_fontInfo) return false;
+
+    const stbtt_fontinfo* font = m_fontInfo.get();
+    const int c = static_cast<int>(codepoint);
+    int w = 0, h = 0, xoff = 0, yoff = 0;
+
+    // Empty glyphs (space) return no bitmap and leave the sizes untouched
+    unsigned char* bitmap = nullptr;
+    if (m_distanceField) {
+        bitmap = stbtt_GetCodepointSDF(
+            font,
+            m_scale,
+            c,
+            m_distanceSpread,
+            128,
+            128.0f / m_distanceSpread,
+            &w,
+            &h,
+            &xoff,
+            &yoff
+        );
+    } else {
+        bitmap = stbtt_GetCodepointBitmap(
+            font,
             0,
-            scale,
+            m_scale,
             c,
             &w,
             &h,
             &xoff,
             &yoff
         );
+    }
 
-        int advance, lsb;
-        stbtt_GetCodepointHMetrics(&font, c, &advance, &lsb);
-
-        GlyphMetrics gm;
-        gm.width    = w;
-        gm.height   = h;
-        gm.advanceX = int(advance * scale);
-        gm.advanceY = 0;
-        gm.bearingX = xoff;
-        gm.bearingY = -yoff; // IMPORTANT for Y-down coordinate system
-
-        m_glyphs[c] = gm;
+    int advance, lsb;
+    stbtt_GetCodepointHMetrics(font, c, &advance, &lsb);
+
+    gm = GlyphMetrics{};
+    gm.width    = w;
+    gm.height   = h;
+    gm.advanceX = int(advance * m_scale);
+    gm.advanceY = 0;
+    gm.bearingX = xoff;
+    gm.bearingY = -yoff; // IMPORTANT for Y-down coordinate system
+
+    bmp.width  = 0;
+    bmp.height = 0;
+    bmp.pixels.clear();
+    if (bitmap && w > 0 && h > 0) {
+        bmp.width  = w;
+        bmp.height = h;
+        bmp.pixels.resize(w * h);
+
+        std::memcpy(bmp.pixels.data(), bitmap, w * h);
+    }
 
-        if (w > 0 && h > 0) {
-            GlyphBitmap bmp;
-            bmp.width  = w;
-            bmp.height = h;
-            bmp.pixels.resize(w * h);
+    if (m_distanceField)
+        stbtt_FreeSDF(bitmap, nullptr);
+    else
+        stbtt_FreeBitmap(bitmap, nullptr);
 
-            std::memcpy(bmp.pixels.data(), bitmap, w * h);
-            m_bitmaps[c] = std::move(bmp);
-        }
+    return true;
+}
 
-        stbtt_FreeBitmap(bitmap, nullptr);
+// ------------------------------------------------------------
+// Atlas packing
+// ------------------------------------------------------------
+namespace {
+
+constexpr int kAtlasPadding = 2;
+constexpr int kMaxAtlasSize = 8192;
+
+struct PackItem {
+    char c;
+    int width;
+    int height;
+};
+
+// Packs every item into a width x height atlas; false if one does not fit
+bool packInto(const std::vector<PackItem>& items, int width, int height,
+              std::vector<PackedRect>& out, int& usedHeight) {
+    // Each rectangle carries its padding on the left and top; the bin
+    // is shrunk by one padding so the right and bottom edges get theirs
+    SkylinePacker packer(width - kAtlasPadding, height - kAtlasPadding);
+    out.resize(items.size());
+    usedHeight = 0;
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        if (!packer.insert(items[i].width + kAtlasPadding, items[i].height + kAtlasPadding, out[i]))
+            return false;
+        usedHeight = std::max(usedHeight, out[i].y + out[i].height + kAtlasPadding);
     }
-
     return true;
 }
 
+} // namespace
+
 bool OpenGLFontAsset::buildAtlas() {
-    constexpr int padding = 2;
-    constexpr int channels = 4;
+    constexpr int padding = kAtlasPadding;
+    constexpr int channels = 1;
+
+    // 1. Glyphs with pixels, tallest first: the skyline stays flat
+    std::vector<PackItem> items;
+    std::size_t glyphArea = 0;
+    std::size_t paddedArea = 0;
+    int widest = 0;
+    for (auto& [c, gm] : m_glyphs) {
+        gm.atlasX = 0;
+        gm.atlasY = 0;
+        if (m_bitmaps.find(c) == m_bitmaps.end())
+            continue;
 
-    // 1. Estimate atlas width (simple heuristic)
-    int estimatedWidth = 512;
-    int x = padding;
-    int y = padding;
-    int rowHeight = 0;
+        items.push_back({ c, gm.width, gm.height });
+        glyphArea  += static_cast<std::size_t>(gm.width) * gm.height;
+        paddedArea += static_cast<std::size_t>(gm.width + padding) * (gm.height + padding);
+        widest = std::max(widest, gm.width + 2 * padding);
+    }
 
-    m_atlasWidth  = estimatedWidth;
-    m_atlasHeight = padding;
+    // Map order is arbitrary; ties are broken by character so builds are reproducible
+    std::sort(items.begin(), items.end(), [](const PackItem& a, const PackItem& b) {
+        if (a.height != b.height) return a.height > b.height;
+        if (a.width != b.width) return a.width > b.width;
+        return a.c < b.c;
+    });
+
+    // 2. Smallest atlas the glyphs fit in
+    std::vector<PackedRect> placed;
+    std::vector<PackedRect> best;
+    int usedHeight = 0;
+    m_atlasWidth = 0;
+    m_atlasHeight = 0;
 
-    // 2. First pass: layout glyphs
-    for (auto& [c, gm] : m_glyphs) {
-        if (x + gm.width + padding > m_atlasWidth) {
-            // new row
-            x = padding;
-            y += rowHeight + padding;
-            rowHeight = 0;
+    if (m_powerOfTwoAtlas) {
+        // Candidates by increasing area: n x n, then 2n x n
+        for (int size = 16; size <= kMaxAtlasSize && m_atlasWidth == 0; size <<= 1) {
+            const int shapes[2][2] = { { size, size }, { size * 2, size } };
+            for (const auto& shape : shapes) {
+                if (shape[0] > kMaxAtlasSize || shape[0] < widest) continue;
+                if (static_cast<std::size_t>(shape[0]) * shape[1] < paddedArea) continue;
+                if (packInto(items, shape[0], shape[1], placed, usedHeight)) {
+                    m_atlasWidth = shape[0];
+                    m_atlasHeight = shape[1];
+                    best.swap(placed);
+                    break;
+                }
+            }
+        }
+    } else {
+        // Try widths from square upwards; the height is whatever the packing used
+        const int start = std::max({ widest, 16, int(std::ceil(std::sqrt(double(paddedArea)))) });
+        std::size_t bestArea = 0;
+        for (int step = 0; step <= 8; ++step) {
+            const int width = std::min((start + start * step / 8 + 3) & ~3, kMaxAtlasSize);
+            if (!packInto(items, width, kMaxAtlasSize, placed, usedHeight))
+                continue;
+
+            const int height = std::max((usedHeight + 3) & ~3, 4);
+            const std::size_t area = static_cast<std::size_t>(width) * height;
+            if (bestArea == 0 || area < bestArea) {
+                bestArea = area;
+                m_atlasWidth = width;
+                m_atlasHeight = height;
+                best.swap(placed);
+            }
         }
-
-        gm.atlasX = x;
-        gm.atlasY = y;
-
-        x += gm.width + padding;
-        rowHeight = std::max(rowHeight, gm.height);
     }
 
-    m_atlasHeight = y + rowHeight + padding;
+    if (m_atlasWidth == 0) {
+        std::cerr << "[OpenGLFontAsset] Glyphs do not fit in a "
+                  << kMaxAtlasSize << "x" << kMaxAtlasSize << " atlas\n";
+        return false;
+    }
 
-    // 3. Round atlas size to power-of-two (OpenGL-friendly)
-    auto nextPOT = [](int v) {
-        int p = 1;
-        while (p < v) p <<= 1;
-        return p;
-    };
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        auto& gm = m_glyphs[items[i].c];
+        gm.atlasX = best[i].x + padding;
+        gm.atlasY = best[i].y + padding;
+    }
 
-    m_atlasWidth  = nextPOT(m_atlasWidth);
-    m_atlasHeight = nextPOT(m_atlasHeight);
+    m_packingEfficiency = float(double(glyphArea) / (double(m_atlasWidth) * m_atlasHeight));
+    std::cout << "[OpenGLFontAsset] Atlas " << m_atlasWidth << "x" << m_atlasHeight
+              << ", " << items.size() << " glyphs, "
+              << int(m_packingEfficiency * 100.0f + 0.5f) << "% used\n";
 
     // 4. Allocate pixel buffer (transparent background)
     m_pixels.assign(m_atlasWidth * m_atlasHeight * channels, 0);
 
-    // 5. Rasterize glyph bitmaps into RGBA atlas
+    // 5. Copy glyph bitmaps into the single-channel atlas
     for (auto& [c, gm] : m_glyphs) {
         auto bmpIt = m_bitmaps.find(c);
         if (bmpIt == m_bitmaps.end())
@@ -179,23 +316,9 @@ bool OpenGLFontAsset::buildAtlas() {
         const GlyphBitmap& bmp = bmpIt->second;
 
         for (int gy = 0; gy < bmp.height; ++gy) {
-            for (int gx = 0; gx < bmp.width; ++gx) {
-                int srcIdx = gy * bmp.width + gx;
-                uint8_t coverage = bmp.pixels[srcIdx];
-
-                int px = gm.atlasX + gx;
-                int py = gm.atlasY + gy;
-
-                int dstIdx = (py * m_atlasWidth + px) * 4;
-
-                // White text, glyph in alpha
-                m_pixels[dstIdx + 0] = 255;
-                m_pixels[dstIdx + 1] = 255;
-                m_pixels[dstIdx + 2] = 255;
-                m_pixels[dstIdx + 3] = coverage;
-
-
-            }
+            std::memcpy(&m_pixels[(gm.atlasY + gy) * m_atlasWidth + gm.atlasX],
+                        &bmp.pixels[gy * bmp.width],
+                        bmp.width);
         }
 
         // 6. Compute UVs
@@ -0,0 +1,983 @@
+#include "retronomicon/graphics/block_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace retronomicon::opengl::graphics {
+
+// ------------------------------------------------------------
+// Format table
+// ------------------------------------------------------------
+struct FormatInfo {
+    CompressedFormat format;
+    const char* name;
+    std::size_t blockBytes;
+    bool alpha;
+};
+
+static const FormatInfo kFormats[] = {
+    { CompressedFormat::RGBA8,     "rgba8", 4,  true  },
+    { CompressedFormat::BC1,       "bc1",   8,  false },
+    { CompressedFormat::BC3,       "bc3",   16, true  },
+    { CompressedFormat::BC7,       "bc7",   16, true  },
+    { CompressedFormat::ETC2_RGB,  "etc2",  8,  false },
+    { CompressedFormat::ETC2_RGBA, "etc2a", 16, true  },
+};
+
+static const FormatInfo& info(CompressedFormat format) {
+    return kFormats[static_cast<std::size_t>(format)];
+}
+
+const char* getFormatName(CompressedFormat format) noexcept { return info(format).name; }
+
+bool parseFormatName(const char* name, CompressedFormat& out) noexcept {
+    for (const auto& f : kFormats) {
+        if (std::strcmp(f.name, name) == 0) {
+            out = f.format;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasAlpha(CompressedFormat format) noexcept { return info(format).alpha; }
+
+std::size_t getBlockBytes(CompressedFormat format) noexcept { return info(format).blockBytes; }
+
+std::size_t getImageSize(CompressedFormat format, int width, int height) noexcept {
+    if (!isBlockFormat(format))
+        return static_cast<std::size_t>(width) * height * 4;
+
+    const std::size_t blocksX = (static_cast<std::size_t>(width) + 3) / 4;
+    const std::size_t blocksY = (static_cast<std::size_t>(height) + 3) / 4;
+    return blocksX * blocksY * getBlockBytes(format);
+}
+
+// ------------------------------------------------------------
+// Shared helpers
+// ------------------------------------------------------------
+static inline uint8_t clamp255(int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+static inline int expand5(int v) { return (v << 3) | (v >> 2); }
+static inline int expand6(int v) { return (v << 2) | (v >> 4); }
+static inline int expand7(int v) { return (v << 1) | (v >> 6); }
+
+static inline uint64_t readBE64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+static inline void writeBE64(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; --i) { p[i] = static_cast<uint8_t>(v); v >>= 8; }
+}
+
+static inline uint32_t bits(uint64_t v, int hi, int lo) {
+    return static_cast<uint32_t>((v >> lo) & ((1ull << (hi - lo + 1)) - 1));
+}
+
+static inline int colorDistance(const uint8_t* a, const int* b, int channels) {
+    int d = 0;
+    for (int c = 0; c < channels; ++c) {
+        int e = a[c] - b[c];
+        d += e * e;
+    }
+    return d;
+}
+
+// Principal axis fit: returns the two extreme points of the texels
+// projected on their main direction of variance.
+static void fitEndpoints(const uint8_t texels[64], int channels, float lo[4], float hi[4]) {
+    float mean[4] = {};
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < channels; ++c) mean[c] += texels[i * 4 + c];
+    for (int c = 0; c < channels; ++c) mean[c] /= 16.0f;
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i) {
+        float d[4];
+        for (int c = 0; c < channels; ++c) d[c] = texels[i * 4 + c] - mean[c];
+        for (int a = 0; a < channels; ++a)
+            for (int b = 0; b < channels; ++b) cov[a][b] += d[a] * d[b];
+    }
+
+    float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (int iter = 0; iter < 8; ++iter) {
+        float next[4] = {};
+        for (int a = 0; a < channels; ++a)
+            for (int b = 0; b < channels; ++b) next[a] += cov[a][b] * axis[b];
+
+        float len = 0.0f;
+        for (int c = 0; c < channels; ++c) len += next[c] * next[c];
+        if (len < 1e-12f) break;
+
+        len = 1.0f / std::sqrt(len);
+        for (int c = 0; c < channels; ++c) axis[c] = next[c] * len;
+    }
+
+    float tMin = 0.0f, tMax = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < channels; ++c) t += (texels[i * 4 + c] - mean[c]) * axis[c];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+
+    for (int c = 0; c < channels; ++c) {
+        lo[c] = std::clamp(mean[c] + tMin * axis[c], 0.0f, 255.0f);
+        hi[c] = std::clamp(mean[c] + tMax * axis[c], 0.0f, 255.0f);
+    }
+}
+
+// ------------------------------------------------------------
+// BC1 color block (also the color half of BC3)
+// ------------------------------------------------------------
+static void bc1Palette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4]) {
+    const int r0 = expand5(c0 >> 11), g0 = expand6((c0 >> 5) & 63), b0 = expand5(c0 & 31);
+    const int r1 = expand5(c1 >> 11), g1 = expand6((c1 >> 5) & 63), b1 = expand5(c1 & 31);
+
+    const int p[4][4] = {
+        { r0, g0, b0, 255 },
+        { r1, g1, b1, 255 },
+        { 0, 0, 0, 0 },
+        { 0, 0, 0, 0 },
+    };
+    std::memcpy(palette, p, sizeof(p));
+
+    if (fourColor || c0 > c1) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        palette[2][3] = palette[3][3] = 255;
+    } else {
+        for (int c = 0; c < 3; ++c)
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+        palette[2][3] = 255;
+        // palette[3] stays transparent black
+    }
+}
+
+static void decodeBC1Block(const uint8_t* src, uint8_t out[64], bool fourColor) {
+    const uint16_t c0 = static_cast<uint16_t>(src[0] | (src[1] << 8));
+    const uint16_t c1 = static_cast<uint16_t>(src[2] | (src[3] << 8));
+    const uint32_t indices = src[4] | (src[5] << 8) | (src[6] << 16) | (static_cast<uint32_t>(src[7]) << 24);
+
+    int palette[4][4];
+    bc1Palette(c0, c1, fourColor, palette);
+
+    for (int i = 0; i < 16; ++i) {
+        const int* p = palette[(indices >> (2 * i)) & 3];
+        for (int c = 0; c < 4; ++c) out[i * 4 + c] = static_cast<uint8_t>(p[c]);
+    }
+}
+
+static inline uint16_t pack565(const float rgb[3]) {
+    const int r = static_cast<int>(rgb[0] * 31.0f / 255.0f + 0.5f);
+    const int g = static_cast<int>(rgb[1] * 63.0f / 255.0f + 0.5f);
+    const int b = static_cast<int>(rgb[2] * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void encodeBC1Block(const uint8_t texels[64], uint8_t* dst) {
+    float lo[4], hi[4];
+    fitEndpoints(texels, 3, lo, hi);
+
+    uint16_t c0 = pack565(hi);
+    uint16_t c1 = pack565(lo);
+    if (c0 < c1) std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][4];
+        bc1Palette(c0, c1, true, palette);
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = colorDistance(&texels[i * 4], palette[0], 3);
+            for (int k = 1; k < 4; ++k) {
+                int e = colorDistance(&texels[i * 4], palette[k], 3);
+                if (e < bestError) { bestError = e; best = k; }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+
+    dst[0] = static_cast<uint8_t>(c0);
+    dst[1] = static_cast<uint8_t>(c0 >> 8);
+    dst[2] = static_cast<uint8_t>(c1);
+    dst[3] = static_cast<uint8_t>(c1 >> 8);
+    dst[4] = static_cast<uint8_t>(indices);
+    dst[5] = static_cast<uint8_t>(indices >> 8);
+    dst[6] = static_cast<uint8_t>(indices >> 16);
+    dst[7] = static_cast<uint8_t>(indices >> 24);
+}
+
+// ------------------------------------------------------------
+// BC3 alpha block
+// ------------------------------------------------------------
+static void bc3AlphaPalette(int a0, int a1, int palette[8]) {
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+    } else {
+        for (int i = 2; i < 6; ++i)
+            palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static void decodeBC3AlphaBlock(const uint8_t* src, uint8_t out[64]) {
+    int palette[8];
+    bc3AlphaPalette(src[0], src[1], palette);
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+        indices |= static_cast<uint64_t>(src[2 + i]) << (8 * i);
+
+    for (int i = 0; i < 16; ++i)
+        out[i * 4 + 3] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+}
+
+static void encodeBC3AlphaBlock(const uint8_t texels[64], uint8_t* dst) {
+    int aMin = 255, aMax = 0;
+    for (int i = 0; i < 16; ++i) {
+        aMin = std::min<int>(aMin, texels[i * 4 + 3]);
+        aMax = std::max<int>(aMax, texels[i * 4 + 3]);
+    }
+
+    int palette[8];
+    bc3AlphaPalette(aMax, aMin, palette);
+
+    uint64_t indices = 0;
+    if (aMax != aMin) {
+        for (int i = 0; i < 16; ++i) {
+            const int a = texels[i * 4 + 3];
+            int best = 0, bestError = 256;
+            for (int k = 0; k < 8; ++k) {
+                int e = std::abs(a - palette[k]);
+                if (e < bestError) { bestError = e; best = k; }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    dst[0] = static_cast<uint8_t>(aMax);
+    dst[1] = static_cast<uint8_t>(aMin);
+    for (int i = 0; i < 6; ++i)
+        dst[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+// ------------------------------------------------------------
+// BC7
+// ------------------------------------------------------------
+struct BC7Mode {
+    int subsets, partitionBits, rotationBits, indexSelectionBits;
+    int colorBits, alphaBits, endpointPBits, sharedPBits;
+    int indexBits, index2Bits;
+};
+
+static const BC7Mode kBC7Modes[8] = {
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+// Subset of each texel for 2-subset partitions, one bit per texel
+static const uint16_t kBC7Partitions2[64] = {
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Subset of each texel for 3-subset partitions
+static const uint8_t kBC7Partitions3[64][16] = {
+    {0,0,1,1,0,0,1,1,0,2,2,1,2,2,2,2}, {0,0,0,1,0,0,1,1,2,2,1,1,2,2,2,1},
+    {0,0,0,0,2,0,0,1,2,2,1,1,2,2,1,1}, {0,2,2,2,0,0,2,2,0,0,1,1,0,1,1,1},
+    {0,0,0,0,0,0,0,0,1,1,2,2,1,1,2,2}, {0,0,1,1,0,0,1,1,0,0,2,2,0,0,2,2},
+    {0,0,2,2,0,0,2,2,1,1,1,1,1,1,1,1}, {0,0,1,1,0,0,1,1,2,2,1,1,2,2,1,1},
+    {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2}, {0,0,0,0,1,1,1,1,1,1,1,1,2,2,2,2},
+    {0,0,0,0,1,1,1,1,2,2,2,2,2,2,2,2}, {0,0,1,2,0,0,1,2,0,0,1,2,0,0,1,2},
+    {0,1,1,2,0,1,1,2,0,1,1,2,0,1,1,2}, {0,1,2,2,0,1,2,2,0,1,2,2,0,1,2,2},
+    {0,0,1,1,0,1,1,2,1,1,2,2,1,2,2,2}, {0,0,1,1,2,0,0,1,2,2,0,0,2,2,2,0},
+    {0,0,0,1,0,0,1,1,0,1,1,2,1,1,2,2}, {0,1,1,1,0,0,1,1,2,0,0,1,2,2,0,0},
+    {0,0,0,0,1,1,2,2,1,1,2,2,1,1,2,2}, {0,0,2,2,0,0,2,2,0,0,2,2,1,1,1,1},
+    {0,1,1,1,0,1,1,1,0,2,2,2,0,2,2,2}, {0,0,0,1,0,0,0,1,2,2,2,1,2,2,2,1},
+    {0,0,0,0,0,0,1,1,0,1,2,2,0,1,2,2}, {0,0,0,0,1,1,0,0,2,2,1,0,2,2,1,0},
+    {0,1,2,2,0,1,2,2,0,0,1,1,0,0,0,0}, {0,0,1,2,0,0,1,2,1,1,2,2,2,2,2,2},
+    {0,1,1,0,1,2,2,1,1,2,2,1,0,1,1,0}, {0,0,0,0,0,1,1,0,1,2,2,1,1,2,2,1},
+    {0,0,2,2,1,1,0,2,1,1,0,2,0,0,2,2}, {0,1,1,0,0,1,1,0,2,0,0,2,2,2,2,2},
+    {0,0,1,1,0,1,2,2,0,1,2,2,0,0,1,1}, {0,0,0,0,2,0,0,0,2,2,1,1,2,2,2,1},
+    {0,0,0,0,0,0,0,2,1,1,2,2,1,2,2,2}, {0,2,2,2,0,0,2,2,0,0,1,2,0,0,1,1},
+    {0,0,1,1,0,0,1,2,0,0,2,2,0,2,2,2}, {0,1,2,0,0,1,2,0,0,1,2,0,0,1,2,0},
+    {0,0,0,0,1,1,1,1,2,2,2,2,0,0,0,0}, {0,1,2,0,1,2,0,1,2,0,1,2,0,1,2,0},
+    {0,1,2,0,2,0,1,2,1,2,0,1,0,1,2,0}, {0,0,1,1,2,2,0,0,1,1,2,2,0,0,1,1},
+    {0,0,1,1,1,1,2,2,2,2,0,0,0,0,1,1}, {0,1,0,1,0,1,0,1,2,2,2,2,2,2,2,2},
+    {0,0,0,0,0,0,0,0,2,1,2,1,2,1,2,1}, {0,0,2,2,1,1,2,2,0,0,2,2,1,1,2,2},
+    {0,0,2,2,0,0,1,1,0,0,2,2,0,0,1,1}, {0,2,2,0,1,2,2,1,0,2,2,0,1,2,2,1},
+    {0,1,0,1,2,2,2,2,2,2,2,2,0,1,0,1}, {0,0,0,0,2,1,2,1,2,1,2,1,2,1,2,1},
+    {0,1,0,1,0,1,0,1,0,1,0,1,2,2,2,2}, {0,2,2,2,0,1,1,1,0,2,2,2,0,1,1,1},
+    {0,0,0,2,1,1,1,2,0,0,0,2,1,1,1,2}, {0,0,0,0,2,1,1,2,2,1,1,2,2,1,1,2},
+    {0,2,2,2,0,1,1,1,0,1,1,1,0,2,2,2}, {0,0,0,2,1,1,1,2,1,1,1,2,0,0,0,2},
+    {0,1,1,0,0,1,1,0,0,1,1,0,2,2,2,2}, {0,0,0,0,0,0,0,0,2,1,1,2,2,1,1,2},
+    {0,1,1,0,0,1,1,0,2,2,2,2,2,2,2,2}, {0,0,2,2,0,0,1,1,0,0,1,1,0,0,2,2},
+    {0,0,2,2,1,1,2,2,1,1,2,2,0,0,2,2}, {0,0,0,0,0,0,0,0,0,0,0,0,2,1,1,2},
+    {0,0,0,2,0,0,0,1,0,0,0,2,0,0,0,1}, {0,2,2,2,1,2,2,2,0,2,2,2,1,2,2,2},
+    {0,1,0,1,2,2,2,2,2,2,2,2,2,2,2,2}, {0,1,1,1,2,0,1,1,2,2,0,1,2,2,2,0},
+};
+
+// Anchor texel of subset 1 in 2-subset partitions
+static const uint8_t kBC7Anchor2[64] = {
+    15,15,15,15,15,15,15,15, 15,15,15,15,15,15,15,15,
+    15, 2, 8, 2, 2, 8, 8,15,  2, 8, 2, 2, 8, 8, 2, 2,
+    15,15, 6, 8, 2, 8,15,15,  2, 8, 2, 2, 2,15,15, 6,
+     6, 2, 6, 8,15,15, 2, 2, 15,15,15,15,15, 2, 2,15,
+};
+
+// Anchor texels of subsets 1 and 2 in 3-subset partitions
+static const uint8_t kBC7Anchor3a[64] = {
+     3, 3,15,15, 8, 3,15,15,  8, 8, 6, 6, 6, 5, 3, 3,
+     3, 3, 8,15, 3, 3, 6,10,  5, 8, 8, 6, 8, 5,15,15,
+     8,15, 3, 5, 6,10, 8,15, 15, 3,15, 5,15,15,15,15,
+     3,15, 5, 5, 5, 8, 5,10,  5,10, 8,13,15,12, 3, 3,
+};
+
+static const uint8_t kBC7Anchor3b[64] = {
+    15, 8, 8, 3,15,15, 3, 8, 15,15,15,15,15,15,15, 8,
+    15, 8,15, 3,15, 8,15, 8,  3,15, 6,10,15,15,10, 8,
+    15, 3,15,10,10, 8, 9,10,  6,15, 8,15, 3, 6, 6, 8,
+    15, 3,15,15,15,15,15,15, 15,15,15,15, 3,15,15, 8,
+};
+
+static const int kBC7Weights2[4]  = { 0, 21, 43, 64 };
+static const int kBC7Weights3[8]  = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const int kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static const int* bc7Weights(int indexBits) {
+    return indexBits == 2 ? kBC7Weights2 : indexBits == 3 ? kBC7Weights3 : kBC7Weights4;
+}
+
+static inline int bc7Interpolate(int e0, int e1, int weight) {
+    return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+}
+
+/** Little-endian bit reader over a 128-bit block */
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* data) : m_data(data) {}
+
+    int read(int count) {
+        int value = 0;
+        for (int i = 0; i < count; ++i, ++m_pos)
+            value |= ((m_data[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+        return value;
+    }
+
+private:
+    const uint8_t* m_data;
+    int m_pos = 0;
+};
+
+/** Little-endian bit writer over a 128-bit block */
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* data) : m_data(data) { std::memset(data, 0, 16); }
+
+    void write(int value, int count) {
+        for (int i = 0; i < count; ++i, ++m_pos)
+            m_data[m_pos >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (m_pos & 7));
+    }
+
+private:
+    uint8_t* m_data;
+    int m_pos = 0;
+};
+
+static int bc7Subset(int subsets, int partition, int texel) {
+    if (subsets == 2) return (kBC7Partitions2[partition] >> texel) & 1;
+    if (subsets == 3) return kBC7Partitions3[partition][texel];
+    return 0;
+}
+
+static bool bc7IsAnchor(int subsets, int partition, int texel) {
+    if (texel == 0) return true;
+    if (subsets == 2) return texel == kBC7Anchor2[partition];
+    if (subsets == 3) return texel == kBC7Anchor3a[partition] || texel == kBC7Anchor3b[partition];
+    return false;
+}
+
+static void decodeBC7Block(const uint8_t* src, uint8_t out[64]) {
+    int modeIndex = 0;
+    while (modeIndex < 8 && !(src[0] & (1 << modeIndex))) ++modeIndex;
+
+    // Reserved mode: transparent black
+    if (modeIndex == 8) {
+        std::memset(out, 0, 64);
+        return;
+    }
+
+    const BC7Mode& mode = kBC7Modes[modeIndex];
+    BitReader reader(src);
+    reader.read(modeIndex + 1);
+
+    const int partition = reader.read(mode.partitionBits);
+    const int rotation = reader.read(mode.rotationBits);
+    const int indexSelection = reader.read(mode.indexSelectionBits);
+
+    // endpoints[subset * 2 + end][channel]
+    int endpoints[6][4] = {};
+    const int ends = mode.subsets * 2;
+
+    for (int c = 0; c < 3; ++c)
+        for (int e = 0; e < ends; ++e) endpoints[e][c] = reader.read(mode.colorBits);
+    if (mode.alphaBits)
+        for (int e = 0; e < ends; ++e) endpoints[e][3] = reader.read(mode.alphaBits);
+
+    int pBits[6] = {};
+    if (mode.endpointPBits) {
+        for (int e = 0; e < ends; ++e) pBits[e] = reader.read(1);
+    } else if (mode.sharedPBits) {
+        for (int s = 0; s < mode.subsets; ++s) pBits[s * 2] = pBits[s * 2 + 1] = reader.read(1);
+    }
+
+    const bool hasPBits = mode.endpointPBits || mode.sharedPBits;
+    for (int e = 0; e < ends; ++e) {
+        for (int c = 0; c < 4; ++c) {
+            int precision = (c < 3) ? mode.colorBits : mode.alphaBits;
+            if (precision == 0) {
+                endpoints[e][c] = 255;
+                continue;
+            }
+
+            int v = endpoints[e][c];
+            if (hasPBits) {
+                v = (v << 1) | pBits[e];
+                ++precision;
+            }
+            v <<= 8 - precision;
+            endpoints[e][c] = v | (v >> precision);
+        }
+    }
+
+    int indices[16], indices2[16] = {};
+    for (int i = 0; i < 16; ++i)
+        indices[i] = reader.read(mode.indexBits - (bc7IsAnchor(mode.subsets, partition, i) ? 1 : 0));
+    if (mode.index2Bits) {
+        for (int i = 0; i < 16; ++i)
+            indices2[i] = reader.read(mode.index2Bits - (i == 0 ? 1 : 0));
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        const int subset = bc7Subset(mode.subsets, partition, i);
+        const int* e0 = endpoints[subset * 2];
+        const int* e1 = endpoints[subset * 2 + 1];
+
+        int colorIndex = indices[i], colorBits = mode.indexBits;
+        int alphaIndex = indices[i], alphaBits = mode.indexBits;
+        if (mode.index2Bits) {
+            alphaIndex = indices2[i];
+            alphaBits = mode.index2Bits;
+            if (indexSelection) {
+                std::swap(colorIndex, alphaIndex);
+                std::swap(colorBits, alphaBits);
+            }
+        }
+
+        int texel[4];
+        for (int c = 0; c < 3; ++c)
+            texel[c] = bc7Interpolate(e0[c], e1[c], bc7Weights(colorBits)[colorIndex]);
+        texel[3] = bc7Interpolate(e0[3], e1[3], bc7Weights(alphaBits)[alphaIndex]);
+
+        if (rotation) std::swap(texel[3], texel[rotation - 1]);
+
+        for (int c = 0; c < 4; ++c) out[i * 4 + c] = static_cast<uint8_t>(texel[c]);
+    }
+}
+
+// Mode 6: one subset, RGBA 7.7.7.7 endpoints with a p-bit each, 4-bit indices
+static void encodeBC7Block(const uint8_t texels[64], uint8_t* dst) {
+    float lo[4], hi[4];
+    fitEndpoints(texels, 4, lo, hi);
+
+    int q[2][4], p[2];
+    const float* ends[2] = { lo, hi };
+    for (int e = 0; e < 2; ++e) {
+        float bestError = 1e30f;
+        for (int pb = 0; pb < 2; ++pb) {
+            int candidate[4];
+            float error = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                candidate[c] = std::clamp(static_cast<int>(std::lround((ends[e][c] - pb) / 2.0f)), 0, 127);
+                const float d = static_cast<float>((candidate[c] << 1) | pb) - ends[e][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                p[e] = pb;
+                std::memcpy(q[e], candidate, sizeof(candidate));
+            }
+        }
+    }
+
+    int palette[16][4];
+    for (int k = 0; k < 16; ++k)
+        for (int c = 0; c < 4; ++c)
+            palette[k][c] = bc7Interpolate((q[0][c] << 1) | p[0], (q[1][c] << 1) | p[1], kBC7Weights4[k]);
+
+    int indices[16];
+    for (int i = 0; i < 16; ++i) {
+        int best = 0, bestError = colorDistance(&texels[i * 4], palette[0], 4);
+        for (int k = 1; k < 16; ++k) {
+            int e = colorDistance(&texels[i * 4], palette[k], 4);
+            if (e < bestError) { bestError = e; best = k; }
+        }
+        indices[i] = best;
+    }
+
+    // The anchor index is stored without its top bit
+    if (indices[0] & 8) {
+        std::swap(q[0], q[1]);
+        std::swap(p[0], p[1]);
+        for (int& index : indices) index = 15 - index;
+    }
+
+    BitWriter writer(dst);
+    writer.write(1 << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.write(q[0][c], 7);
+        writer.write(q[1][c], 7);
+    }
+    writer.write(p[0], 1);
+    writer.write(p[1], 1);
+    for (int i = 0; i < 16; ++i)
+        writer.write(indices[i], i == 0 ? 3 : 4);
+}
+
+// ------------------------------------------------------------
+// ETC2 RGB
+// ------------------------------------------------------------
+static const int kEtcModifiers[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 },
+};
+
+static const int kEtcDistances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static inline int etcModifier(int table, int index) {
+    const int m = kEtcModifiers[table][index & 1];
+    return (index & 2) ? -m : m;
+}
+
+// Pixel p = x * 4 + y: MSB in bits 16..31, LSB in bits 0..15
+static inline int etcPixelIndex(uint64_t block, int p) {
+    return static_cast<int>((((block >> (16 + p)) & 1) << 1) | ((block >> p) & 1));
+}
+
+static void decodeETC2Block(const uint8_t* src, uint8_t out[64]) {
+    const uint64_t block = readBE64(src);
+    const bool diff = bits(block, 33, 33) != 0;
+    const bool flip = bits(block, 32, 32) != 0;
+
+    auto put = [&](int x, int y, int r, int g, int b) {
+        uint8_t* t = &out[(y * 4 + x) * 4];
+        t[0] = clamp255(r);
+        t[1] = clamp255(g);
+        t[2] = clamp255(b);
+        t[3] = 255;
+    };
+
+    int base[2][3];
+    if (diff) {
+        const int r = static_cast<int>(bits(block, 63, 59));
+        const int g = static_cast<int>(bits(block, 55, 51));
+        const int b = static_cast<int>(bits(block, 47, 43));
+        const int dr = (static_cast<int>(bits(block, 58, 56)) ^ 4) - 4;
+        const int dg = (static_cast<int>(bits(block, 50, 48)) ^ 4) - 4;
+        const int db = (static_cast<int>(bits(block, 42, 40)) ^ 4) - 4;
+
+        if (r + dr < 0 || r + dr > 31) {
+            // T mode
+            const int c1[3] = {
+                static_cast<int>((bits(block, 60, 59) << 2) | bits(block, 57, 56)) * 17,
+                static_cast<int>(bits(block, 55, 52)) * 17,
+                static_cast<int>(bits(block, 51, 48)) * 17,
+            };
+            const int c2[3] = {
+                static_cast<int>(bits(block, 47, 44)) * 17,
+                static_cast<int>(bits(block, 43, 40)) * 17,
+                static_cast<int>(bits(block, 39, 36)) * 17,
+            };
+            const int d = kEtcDistances[(bits(block, 35, 34) << 1) | bits(block, 32, 32)];
+            const int paint[4][3] = {
+                { c1[0], c1[1], c1[2] },
+                { c2[0] + d, c2[1] + d, c2[2] + d },
+                { c2[0], c2[1], c2[2] },
+                { c2[0] - d, c2[1] - d, c2[2] - d },
+            };
+            for (int x = 0; x < 4; ++x)
+                for (int y = 0; y < 4; ++y) {
+                    const int* c = paint[etcPixelIndex(block, x * 4 + y)];
+                    put(x, y, c[0], c[1], c[2]);
+                }
+            return;
+        }
+
+        if (g + dg < 0 || g + dg > 31) {
+            // H mode
+            const int r1 = static_cast<int>(bits(block, 62, 59));
+            const int g1 = static_cast<int>((bits(block, 58, 56) << 1) | bits(block, 52, 52));
+            const int b1 = static_cast<int>((bits(block, 51, 51) << 3) | bits(block, 49, 47));
+            const int r2 = static_cast<int>(bits(block, 46, 43));
+            const int g2 = static_cast<int>(bits(block, 42, 39));
+            const int b2 = static_cast<int>(bits(block, 38, 35));
+
+            const int order = ((r1 << 8) | (g1 << 4) | b1) >= ((r2 << 8) | (g2 << 4) | b2) ? 1 : 0;
+            const int d = kEtcDistances[(bits(block, 34, 34) << 2) | (bits(block, 32, 32) << 1) | order];
+
+            const int paint[4][3] = {
+                { r1 * 17 + d, g1 * 17 + d, b1 * 17 + d },
+                { r1 * 17 - d, g1 * 17 - d, b1 * 17 - d },
+                { r2 * 17 + d, g2 * 17 + d, b2 * 17 + d },
+                { r2 * 17 - d, g2 * 17 - d, b2 * 17 - d },
+            };
+            for (int x = 0; x < 4; ++x)
+                for (int y = 0; y < 4; ++y) {
+                    const int* c = paint[etcPixelIndex(block, x * 4 + y)];
+                    put(x, y, c[0], c[1], c[2]);
+                }
+            return;
+        }
+
+        if (b + db < 0 || b + db > 31) {
+            // Planar mode
+            const int ro = expand6(static_cast<int>(bits(block, 62, 57)));
+            const int go = expand7(static_cast<int>((bits(block, 56, 56) << 6) | bits(block, 54, 49)));
+            const int bo = expand6(static_cast<int>((bits(block, 48, 48) << 5) | (bits(block, 44, 43) << 3)
+                                                    | bits(block, 41, 39)));
+            const int rh = expand6(static_cast<int>((bits(block, 38, 34) << 1) | bits(block, 32, 32)));
+            const int gh = expand7(static_cast<int>(bits(block, 31, 25)));
+            const int bh = expand6(static_cast<int>(bits(block, 24, 19)));
+            const int rv = expand6(static_cast<int>(bits(block, 18, 13)));
+            const int gv = expand7(static_cast<int>(bits(block, 12, 6)));
+            const int bv = expand6(static_cast<int>(bits(block, 5, 0)));
+
+            for (int x = 0; x < 4; ++x)
+                for (int y = 0; y < 4; ++y) {
+                    put(x, y,
+                        (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                        (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                        (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+                }
+            return;
+        }
+
+        base[0][0] = expand5(r);      base[0][1] = expand5(g);      base[0][2] = expand5(b);
+        base[1][0] = expand5(r + dr); base[1][1] = expand5(g + dg); base[1][2] = expand5(b + db);
+    } else {
+        base[0][0] = static_cast<int>(bits(block, 63, 60)) * 17;
+        base[1][0] = static_cast<int>(bits(block, 59, 56)) * 17;
+        base[0][1] = static_cast<int>(bits(block, 55, 52)) * 17;
+        base[1][1] = static_cast<int>(bits(block, 51, 48)) * 17;
+        base[0][2] = static_cast<int>(bits(block, 47, 44)) * 17;
+        base[1][2] = static_cast<int>(bits(block, 43, 40)) * 17;
+    }
+
+    const int tables[2] = { static_cast<int>(bits(block, 39, 37)), static_cast<int>(bits(block, 36, 34)) };
+    for (int x = 0; x < 4; ++x)
+        for (int y = 0; y < 4; ++y) {
+            const int sub = flip ? (y >= 2) : (x >= 2);
+            const int m = etcModifier(tables[sub], etcPixelIndex(block, x * 4 + y));
+            put(x, y, base[sub][0] + m, base[sub][1] + m, base[sub][2] + m);
+        }
+}
+
+// Best table for one sub-block; returns its error and fills the pixel indices
+static int etcFitSubblock(const uint8_t texels[64], const int base[3], bool flip, int sub,
+                          int& bestTable, int indices[16]) {
+    int bestError = 0x7FFFFFFF;
+    int candidate[16];
+
+    for (int table = 0; table < 8; ++table) {
+        int error = 0;
+        for (int x = 0; x < 4; ++x)
+            for (int y = 0; y < 4; ++y) {
+                if ((flip ? (y >= 2) : (x >= 2)) != (sub != 0)) continue;
+
+                const uint8_t* t = &texels[(y * 4 + x) * 4];
+                int best = 0, bestPixel = 0x7FFFFFFF;
+                for (int k = 0; k < 4; ++k) {
+                    const int m = etcModifier(table, k);
+                    const int c[3] = { clamp255(base[0] + m), clamp255(base[1] + m), clamp255(base[2] + m) };
+                    const int e = colorDistance(t, c, 3);
+                    if (e < bestPixel) { bestPixel = e; best = k; }
+                }
+                candidate[x * 4 + y] = best;
+                error += bestPixel;
+            }
+
+        if (error < bestError) {
+            bestError = error;
+            bestTable = table;
+            for (int p = 0; p < 16; ++p) {
+                const int x = p / 4, y = p % 4;
+                if ((flip ? (y >= 2) : (x >= 2)) == (sub != 0)) indices[p] = candidate[p];
+            }
+        }
+    }
+    return bestError;
+}
+
+// ETC1-compatible individual/differential modes (valid ETC2)
+static void encodeETC2Block(const uint8_t texels[64], uint8_t* dst) {
+    uint64_t bestBlock = 0;
+    int bestError = 0x7FFFFFFF;
+
+    for (int flip = 0; flip < 2; ++flip) {
+        float avg[2][3] = {};
+        for (int x = 0; x < 4; ++x)
+            for (int y = 0; y < 4; ++y) {
+                const int sub = flip ? (y >= 2) : (x >= 2);
+                for (int c = 0; c < 3; ++c) avg[sub][c] += texels[(y * 4 + x) * 4 + c] / 8.0f;
+            }
+
+        int q5[2][3], q4[2][3];
+        bool differential = true;
+        for (int s = 0; s < 2; ++s)
+            for (int c = 0; c < 3; ++c) {
+                q5[s][c] = std::clamp(static_cast<int>(avg[s][c] * 31.0f / 255.0f + 0.5f), 0, 31);
+                q4[s][c] = std::clamp(static_cast<int>(avg[s][c] * 15.0f / 255.0f + 0.5f), 0, 15);
+            }
+        for (int c = 0; c < 3; ++c) {
+            const int d = q5[1][c] - q5[0][c];
+            if (d < -4 || d > 3) differential = false;
+        }
+
+        int base[2][3];
+        for (int s = 0; s < 2; ++s)
+            for (int c = 0; c < 3; ++c)
+                base[s][c] = differential ? expand5(q5[s][c]) : q4[s][c] * 17;
+
+        int tables[2], indices[16] = {};
+        const int error = etcFitSubblock(texels, base[0], flip, 0, tables[0], indices)
+                        + etcFitSubblock(texels, base[1], flip, 1, tables[1], indices);
+        if (error >= bestError) continue;
+        bestError = error;
+
+        uint64_t block = 0;
+        if (differential) {
+            block |= static_cast<uint64_t>(q5[0][0]) << 59;
+            block |= static_cast<uint64_t>((q5[1][0] - q5[0][0]) & 7) << 56;
+            block |= static_cast<uint64_t>(q5[0][1]) << 51;
+            block |= static_cast<uint64_t>((q5[1][1] - q5[0][1]) & 7) << 48;
+            block |= static_cast<uint64_t>(q5[0][2]) << 43;
+            block |= static_cast<uint64_t>((q5[1][2] - q5[0][2]) & 7) << 40;
+            block |= 1ull << 33;
+        } else {
+            block |= static_cast<uint64_t>(q4[0][0]) << 60;
+            block |= static_cast<uint64_t>(q4[1][0]) << 56;
+            block |= static_cast<uint64_t>(q4[0][1]) << 52;
+            block |= static_cast<uint64_t>(q4[1][1]) << 48;
+            block |= static_cast<uint64_t>(q4[0][2]) << 44;
+            block |= static_cast<uint64_t>(q4[1][2]) << 40;
+        }
+        block |= static_cast<uint64_t>(tables[0]) << 37;
+        block |= static_cast<uint64_t>(tables[1]) << 34;
+        block |= static_cast<uint64_t>(flip) << 32;
+
+        for (int p = 0; p < 16; ++p) {
+            block |= static_cast<uint64_t>(indices[p] >> 1) << (16 + p);
+            block |= static_cast<uint64_t>(indices[p] & 1) << p;
+        }
+        bestBlock = block;
+    }
+
+    writeBE64(dst, bestBlock);
+}
+
+// ------------------------------------------------------------
+// EAC alpha (alpha half of ETC2 RGBA)
+// ------------------------------------------------------------
+static const int kEacModifiers[16][8] = {
+    { -3, -6,  -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5,  -8, -13, 1, 4, 7, 12 }, { -2, -4,  -6, -13, 1, 3, 5, 12 },
+    { -3, -6,  -8, -12, 2, 5, 7, 11 }, { -3, -7,  -9, -11, 2, 6, 8, 10 },
+    { -4, -7,  -8, -11, 3, 6, 7, 10 }, { -3, -5,  -8, -11, 2, 4, 7, 10 },
+    { -2, -6,  -8, -10, 1, 5, 7,  9 }, { -2, -5,  -8, -10, 1, 4, 7,  9 },
+    { -2, -4,  -8, -10, 1, 3, 7,  9 }, { -2, -5,  -7, -10, 1, 4, 6,  9 },
+    { -3, -4,  -7, -10, 2, 3, 6,  9 }, { -1, -2,  -3, -10, 0, 1, 2,  9 },
+    { -4, -6,  -8,  -9, 3, 5, 7,  8 }, { -3, -5,  -7,  -9, 2, 4, 6,  8 },
+};
+
+static void decodeEACAlphaBlock(const uint8_t* src, uint8_t out[64]) {
+    const uint64_t block = readBE64(src);
+    const int base = static_cast<int>(bits(block, 63, 56));
+    const int multiplier = static_cast<int>(bits(block, 55, 52));
+    const int* modifiers = kEacModifiers[bits(block, 51, 48)];
+
+    for (int x = 0; x < 4; ++x)
+        for (int y = 0; y < 4; ++y) {
+            const int p = x * 4 + y;
+            const int index = static_cast<int>((block >> (45 - 3 * p)) & 7);
+            out[(y * 4 + x) * 4 + 3] = clamp255(base + modifiers[index] * multiplier);
+        }
+}
+
+static void encodeEACAlphaBlock(const uint8_t texels[64], uint8_t* dst) {
+    int alpha[16];
+    int aMin = 255, aMax = 0;
+    for (int x = 0; x < 4; ++x)
+        for (int y = 0; y < 4; ++y) {
+            alpha[x * 4 + y] = texels[(y * 4 + x) * 4 + 3];
+            aMin = std::min(aMin, alpha[x * 4 + y]);
+            aMax = std::max(aMax, alpha[x * 4 + y]);
+        }
+
+    uint64_t bestBlock = 0;
+    int bestError = 0x7FFFFFFF;
+
+    for (int table = 0; table < 16; ++table) {
+        const int* modifiers = kEacModifiers[table];
+        const int tMin = modifiers[3], tMax = modifiers[7];
+        const int guess = std::max(1, static_cast<int>(std::lround(static_cast<float>(aMax - aMin) / (tMax - tMin))));
+
+        for (int multiplier = guess - 1; multiplier <= guess + 1; ++multiplier) {
+            if (multiplier < 1 || multiplier > 15) continue;
+
+            const int base = std::clamp(static_cast<int>(std::lround((aMin + aMax) / 2.0f
+                                                                     - (tMin + tMax) * multiplier / 2.0f)), 0, 255);
+            int error = 0;
+            uint64_t indexBits = 0;
+            for (int p = 0; p < 16; ++p) {
+                int best = 0, bestPixel = 0x7FFFFFFF;
+                for (int k = 0; k < 8; ++k) {
+                    const int e = std::abs(alpha[p] - clamp255(base + modifiers[k] * multiplier));
+                    if (e < bestPixel) { bestPixel = e; best = k; }
+                }
+                error += bestPixel * bestPixel;
+                indexBits |= static_cast<uint64_t>(best) << (45 - 3 * p);
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                bestBlock = (static_cast<uint64_t>(base) << 56)
+                          | (static_cast<uint64_t>(multiplier) << 52)
+                          | (static_cast<uint64_t>(table) << 48)
+                          | indexBits;
+            }
+        }
+    }
+
+    writeBE64(dst, bestBlock);
+}
+
+// ------------------------------------------------------------
+// Image level
+// ------------------------------------------------------------
+static void decodeBlock(CompressedFormat format, const uint8_t* src, uint8_t out[64]) {
+    switch (format) {
+        case CompressedFormat::BC1:
+            decodeBC1Block(src, out, false);
+            for (int i = 0; i < 16; ++i) out[i * 4 + 3] = 255;
+            break;
+        case CompressedFormat::BC3:
+            decodeBC1Block(src + 8, out, true);
+            decodeBC3AlphaBlock(src, out);
+            break;
+        case CompressedFormat::BC7:
+            decodeBC7Block(src, out);
+            break;
+        case CompressedFormat::ETC2_RGB:
+            decodeETC2Block(src, out);
+            break;
+        case CompressedFormat::ETC2_RGBA:
+            decodeETC2Block(src + 8, out);
+            decodeEACAlphaBlock(src, out);
+            break;
+        case CompressedFormat::RGBA8:
+            break;
+    }
+}
+
+static void encodeBlock(CompressedFormat format, const uint8_t texels[64], uint8_t* dst) {
+    switch (format) {
+        case CompressedFormat::BC1:
+            encodeBC1Block(texels, dst);
+            break;
+        case CompressedFormat::BC3:
+            encodeBC3AlphaBlock(texels, dst);
+            encodeBC1Block(texels, dst + 8);
+            break;
+        case CompressedFormat::BC7:
+            encodeBC7Block(texels, dst);
+            break;
+        case CompressedFormat::ETC2_RGB:
+            encodeETC2Block(texels, dst);
+            break;
+        case CompressedFormat::ETC2_RGBA:
+            encodeEACAlphaBlock(texels, dst);
+            encodeETC2Block(texels, dst + 8);
+            break;
+        case CompressedFormat::RGBA8:
+            break;
+    }
+}
+
+void decodeImage(CompressedFormat format, const uint8_t* src, int width, int height, uint8_t* rgba) {
+    if (!isBlockFormat(format)) {
+        std::memcpy(rgba, src, getImageSize(format, width, height));
+        return;
+    }
+
+    const std::size_t blockBytes = getBlockBytes(format);
+    uint8_t texels[64];
+
+    for (int by = 0; by < height; by += 4)
+        for (int bx = 0; bx < width; bx += 4) {
+            decodeBlock(format, src, texels);
+            src += blockBytes;
+
+            for (int y = 0; y < 4 && by + y < height; ++y)
+                for (int x = 0; x < 4 && bx + x < width; ++x)
+                    std::memcpy(&rgba[((static_cast<std::size_t>(by) + y) * width + bx + x) * 4],
+                                &texels[(y * 4 + x) * 4], 4);
+        }
+}
+
+void encodeImage(CompressedFormat format, const uint8_t* rgba, int width, int height, uint8_t* dst) {
+    if (!isBlockFormat(format)) {
+        std::memcpy(dst, rgba, getImageSize(format, width, height));
+        return;
+    }
+
+    const std::size_t blockBytes = getBlockBytes(format);
+    uint8_t texels[64];
+
+    for (int by = 0; by < height; by += 4)
+        for (int bx = 0; bx < width; bx += 4) {
+            // Partial blocks replicate the last row / column
+            for (int y = 0; y < 4; ++y)
+                for (int x = 0; x < 4; ++x) {
+                    const int sx = std::min(bx + x, width - 1);
+                    const int sy = std::min(by + y, height - 1);
+                    std::memcpy(&texels[(y * 4 + x) * 4],
+                                &rgba[(static_cast<std::size_t>(sy) * width + sx) * 4], 4);
+                }
+
+            encodeBlock(format, texels, dst);
+            dst += blockBytes;
+        }
+}
+
+} // namespace retronomicon::opengl::graphics
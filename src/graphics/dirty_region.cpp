@@ -0,0 +1,98 @@
+#include "retronomicon/graphics/dirty_region.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace retronomicon::opengl::graphics {
+
+static long long area(const PackedRect& r) {
+    return static_cast<long long>(r.width) * r.height;
+}
+
+static PackedRect bounds(const PackedRect& a, const PackedRect& b) {
+    const int x0 = std::min(a.x, b.x);
+    const int y0 = std::min(a.y, b.y);
+    const int x1 = std::max(a.x + a.width, b.x + b.width);
+    const int y1 = std::max(a.y + a.height, b.y + b.height);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Pixels the bounding box adds on top of both rectangles (negative when they overlap)
+static long long mergeCost(const PackedRect& a, const PackedRect& b) {
+    return area(bounds(a, b)) - area(a) - area(b);
+}
+
+DirtyRegion::DirtyRegion(int width, int height, std::size_t maxRects)
+    : m_maxRects(std::max<std::size_t>(maxRects, 1)) {
+    reset(width, height);
+}
+
+void DirtyRegion::reset(int width, int height) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_rects.clear();
+}
+
+void DirtyRegion::add(int x, int y, int width, int height) {
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + width, m_width);
+    const int y1 = std::min(y + height, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    m_rects.push_back({ x0, y0, x1 - x0, y1 - y0 });
+    absorb(m_rects.size() - 1);
+
+    if (m_rects.size() > m_maxRects)
+        reduce();
+}
+
+void DirtyRegion::absorb(std::size_t index) {
+    // A merged rectangle may now combine with ones it skipped before
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (std::size_t i = 0; i < m_rects.size(); ++i) {
+            if (i == index || mergeCost(m_rects[i], m_rects[index]) > 0) continue;
+
+            m_rects[index] = bounds(m_rects[i], m_rects[index]);
+            m_rects[i] = m_rects.back();
+            m_rects.pop_back();
+            if (index == m_rects.size()) index = i;
+            merged = true;
+            break;
+        }
+    }
+}
+
+void DirtyRegion::reduce() {
+    while (m_rects.size() > m_maxRects) {
+        std::size_t bestA = 0, bestB = 1;
+        long long bestCost = std::numeric_limits<long long>::max();
+
+        for (std::size_t a = 0; a < m_rects.size(); ++a) {
+            for (std::size_t b = a + 1; b < m_rects.size(); ++b) {
+                const long long cost = mergeCost(m_rects[a], m_rects[b]);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+
+        m_rects[bestA] = bounds(m_rects[bestA], m_rects[bestB]);
+        m_rects[bestB] = m_rects.back();
+        m_rects.pop_back();
+        absorb(bestA);
+    }
+}
+
+std::size_t DirtyRegion::getArea() const noexcept {
+    std::size_t total = 0;
+    for (const auto& rect : m_rects)
+        total += static_cast<std::size_t>(area(rect));
+    return total;
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,270 @@
+#include "retronomicon/graphics/ktx2_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace retronomicon::opengl::graphics {
+
+static const uint8_t kIdentifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+// Header (9 x u32) and index (4 x u32 + 2 x u64) following the identifier
+static constexpr std::size_t kHeaderSize = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+static constexpr std::size_t kLevelEntrySize = 3 * 8;
+
+// ------------------------------------------------------------
+// Format mapping
+// ------------------------------------------------------------
+struct VkFormatEntry {
+    uint32_t vkFormat;
+    CompressedFormat format;
+};
+
+static const VkFormatEntry kVkFormats[] = {
+    { 37,  CompressedFormat::RGBA8 },      // VK_FORMAT_R8G8B8A8_UNORM
+    { 131, CompressedFormat::BC1 },        // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    { 137, CompressedFormat::BC3 },        // VK_FORMAT_BC3_UNORM_BLOCK
+    { 145, CompressedFormat::BC7 },        // VK_FORMAT_BC7_UNORM_BLOCK
+    { 147, CompressedFormat::ETC2_RGB },   // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    { 151, CompressedFormat::ETC2_RGBA },  // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+};
+
+static bool fromVkFormat(uint32_t vkFormat, CompressedFormat& out) {
+    for (const auto& entry : kVkFormats) {
+        if (entry.vkFormat == vkFormat) {
+            out = entry.format;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t toVkFormat(CompressedFormat format) {
+    for (const auto& entry : kVkFormats)
+        if (entry.format == format) return entry.vkFormat;
+    return 0;
+}
+
+// ------------------------------------------------------------
+// Little-endian helpers
+// ------------------------------------------------------------
+static uint32_t read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint64_t read64(const uint8_t* p) {
+    return read32(p) | (static_cast<uint64_t>(read32(p + 4)) << 32);
+}
+
+static void put8(std::vector<uint8_t>& out, uint8_t v) { out.push_back(v); }
+
+static void put16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, static_cast<uint16_t>(v));
+    put16(out, static_cast<uint16_t>(v >> 16));
+}
+
+static void put64(std::vector<uint8_t>& out, uint64_t v) {
+    put32(out, static_cast<uint32_t>(v));
+    put32(out, static_cast<uint32_t>(v >> 32));
+}
+
+static void patch64(std::vector<uint8_t>& out, std::size_t at, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out[at + i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+// ------------------------------------------------------------
+// Reading
+// ------------------------------------------------------------
+Ktx2Image parseKtx2(const uint8_t* data, std::size_t size) {
+    if (size < kHeaderSize || std::memcmp(data, kIdentifier, sizeof(kIdentifier)) != 0)
+        throw std::runtime_error("Ktx2: not a KTX2 file");
+
+    const uint8_t* header = data + sizeof(kIdentifier);
+    const uint32_t vkFormat       = read32(header + 0);
+    const uint32_t width          = read32(header + 8);
+    const uint32_t height         = read32(header + 12);
+    const uint32_t depth          = read32(header + 16);
+    const uint32_t layers         = read32(header + 20);
+    const uint32_t faces          = read32(header + 24);
+    const uint32_t levelCount     = read32(header + 28);
+    const uint32_t supercompression = read32(header + 32);
+
+    Ktx2Image image;
+    if (!fromVkFormat(vkFormat, image.format))
+        throw std::runtime_error("Ktx2: unsupported vkFormat " + std::to_string(vkFormat));
+    if (supercompression != 0)
+        throw std::runtime_error("Ktx2: supercompressed files are not supported");
+    if (width == 0 || height == 0 || depth > 1 || layers > 1 || faces != 1)
+        throw std::runtime_error("Ktx2: only single 2D images are supported");
+    if (width > 16384 || height > 16384)
+        throw std::runtime_error("Ktx2: image too large");
+
+    image.width = static_cast<int>(width);
+    image.height = static_cast<int>(height);
+
+    // levelCount 0 asks the loader to generate mips; the file holds level 0 only
+    const uint32_t stored = levelCount == 0 ? 1 : levelCount;
+    if (stored > 15 || kHeaderSize + stored * kLevelEntrySize > size)
+        throw std::runtime_error("Ktx2: truncated level index");
+
+    const uint8_t* index = data + kHeaderSize;
+    image.levels.resize(stored);
+    for (uint32_t level = 0; level < stored; ++level) {
+        const uint64_t offset = read64(index + level * kLevelEntrySize);
+        const uint64_t length = read64(index + level * kLevelEntrySize + 8);
+        const std::size_t expected = getImageSize(image.format,
+                                                  getMipSize(image.width, level),
+                                                  getMipSize(image.height, level));
+
+        if (length != expected || offset > size || length > size - offset)
+            throw std::runtime_error("Ktx2: invalid level " + std::to_string(level));
+
+        image.levels[level].assign(data + offset, data + offset + length);
+    }
+
+    return image;
+}
+
+Ktx2Image loadKtx2(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Ktx2: cannot open " + path);
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parseKtx2(data.data(), data.size());
+}
+
+// ------------------------------------------------------------
+// Writing
+// ------------------------------------------------------------
+
+// Basic data format descriptor for each supported format
+static std::vector<uint8_t> buildDescriptor(CompressedFormat format) {
+    struct Sample {
+        uint16_t bitOffset;
+        uint8_t bitLength;
+        uint8_t channel;
+    };
+
+    uint8_t model = 0;
+    std::vector<Sample> samples;
+    switch (format) {
+        case CompressedFormat::RGBA8:
+            model = 1;    // KHR_DF_MODEL_RGBSDA
+            samples = { { 0, 8, 0 }, { 8, 8, 1 }, { 16, 8, 2 }, { 24, 8, 15 } };
+            break;
+        case CompressedFormat::BC1:
+            model = 128;  // KHR_DF_MODEL_BC1A
+            samples = { { 0, 64, 0 } };
+            break;
+        case CompressedFormat::BC3:
+            model = 130;  // KHR_DF_MODEL_BC3
+            samples = { { 0, 64, 15 }, { 64, 64, 0 } };
+            break;
+        case CompressedFormat::BC7:
+            model = 133;  // KHR_DF_MODEL_BC7
+            samples = { { 0, 128, 0 } };
+            break;
+        case CompressedFormat::ETC2_RGB:
+            model = 161;  // KHR_DF_MODEL_ETC2
+            samples = { { 0, 64, 2 } };
+            break;
+        case CompressedFormat::ETC2_RGBA:
+            model = 161;
+            samples = { { 0, 64, 15 }, { 64, 64, 2 } };
+            break;
+    }
+
+    const bool block = isBlockFormat(format);
+    const uint16_t blockSize = static_cast<uint16_t>(24 + 16 * samples.size());
+
+    std::vector<uint8_t> out;
+    put32(out, 4u + blockSize);          // dfdTotalSize
+    put32(out, 0);                       // vendorId 0 (Khronos), descriptorType 0 (basic)
+    put16(out, 2);                       // versionNumber
+    put16(out, blockSize);
+    put8(out, model);
+    put8(out, 1);                        // primaries: BT.709
+    put8(out, 1);                        // transfer: linear
+    put8(out, 0);                        // flags: straight alpha
+    for (int i = 0; i < 4; ++i)          // texel block dimensions minus one
+        put8(out, (block && i < 2) ? 3 : 0);
+    put8(out, static_cast<uint8_t>(getBlockBytes(format)));
+    for (int i = 1; i < 8; ++i) put8(out, 0);
+
+    for (const auto& sample : samples) {
+        put16(out, sample.bitOffset);
+        put8(out, static_cast<uint8_t>(sample.bitLength - 1));
+        put8(out, sample.channel);
+        put32(out, 0);                   // sample position
+        put32(out, 0);                   // sampleLower
+        put32(out, block ? 0xFFFFFFFFu : 0xFFu);
+    }
+    return out;
+}
+
+void saveKtx2(const std::string& path, const Ktx2Image& image) {
+    if (image.width <= 0 || image.height <= 0 || image.levels.empty())
+        throw std::runtime_error("Ktx2: empty image");
+
+    for (std::size_t level = 0; level < image.levels.size(); ++level) {
+        const std::size_t expected = getImageSize(image.format,
+                                                  getMipSize(image.width, static_cast<int>(level)),
+                                                  getMipSize(image.height, static_cast<int>(level)));
+        if (image.levels[level].size() != expected)
+            throw std::runtime_error("Ktx2: level " + std::to_string(level) + " has the wrong size");
+    }
+
+    const std::vector<uint8_t> descriptor = buildDescriptor(image.format);
+    const uint32_t levelCount = static_cast<uint32_t>(image.levels.size());
+    const uint32_t dfdOffset = static_cast<uint32_t>(kHeaderSize + levelCount * kLevelEntrySize);
+
+    std::vector<uint8_t> out(kIdentifier, kIdentifier + sizeof(kIdentifier));
+    put32(out, toVkFormat(image.format));
+    put32(out, 1);                       // typeSize
+    put32(out, static_cast<uint32_t>(image.width));
+    put32(out, static_cast<uint32_t>(image.height));
+    put32(out, 0);                       // pixelDepth
+    put32(out, 0);                       // layerCount
+    put32(out, 1);                       // faceCount
+    put32(out, levelCount);
+    put32(out, 0);                       // supercompressionScheme
+
+    put32(out, dfdOffset);
+    put32(out, static_cast<uint32_t>(descriptor.size()));
+    put32(out, 0);                       // no key/value data
+    put32(out, 0);
+    put64(out, 0);                       // no supercompression global data
+    put64(out, 0);
+
+    const std::size_t levelIndex = out.size();
+    out.resize(out.size() + levelCount * kLevelEntrySize, 0);
+    out.insert(out.end(), descriptor.begin(), descriptor.end());
+
+    // Level data is stored smallest first, each aligned to its block size
+    const std::size_t alignment = isBlockFormat(image.format) ? getBlockBytes(image.format) : 4;
+    for (uint32_t level = levelCount; level-- > 0;) {
+        while (out.size() % alignment) out.push_back(0);
+
+        const auto& data = image.levels[level];
+        const std::size_t entry = levelIndex + level * kLevelEntrySize;
+        patch64(out, entry, out.size());
+        patch64(out, entry + 8, data.size());
+        patch64(out, entry + 16, data.size());
+        out.insert(out.end(), data.begin(), data.end());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size())))
+        throw std::runtime_error("Ktx2: cannot write " + path);
+}
+
+} // namespace retronomicon::opengl::graphics
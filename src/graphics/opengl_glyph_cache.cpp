@@ -0,0 +1,161 @@
+#include "retronomicon/graphics/opengl_glyph_cache.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace retronomicon::opengl::graphics {
+
+/** Transparent border keeping linear filtering inside each glyph */
+static constexpr int kPadding = 1;
+
+OpenGLGlyphCache::OpenGLGlyphCache(std::shared_ptr<OpenGLFontAsset> font,
+                                   int pageSize,
+                                   std::size_t maxPages)
+    : m_font(std::move(font))
+    , m_pageSize(std::max(pageSize, 64))
+    , m_maxPages(std::clamp<std::size_t>(maxPages, 1, 0xFFFF)) {
+    if (!m_font)
+        throw std::runtime_error("OpenGLGlyphCache — font is null!");
+}
+
+const OpenGLGlyphCache::Glyph* OpenGLGlyphCache::getGlyph(uint32_t codepoint) {
+    auto it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end()) {
+        if (it->second.metrics.width > 0)
+            m_pages[it->second.page].lastUsed = m_frame;
+        return &it->second;
+    }
+
+    Glyph glyph;
+    if (!m_font->rasterizeGlyph(codepoint, m_bitmap, glyph.metrics))
+        return nullptr;
+    ++m_rasterized;
+
+    // Blank glyphs only carry metrics and never occupy a page
+    if (m_bitmap.pixels.empty()) {
+        glyph.metrics.width = 0;
+        glyph.metrics.height = 0;
+        return &m_glyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    PackedRect slot;
+    const int page = allocate(m_bitmap.width + 2 * kPadding, m_bitmap.height + 2 * kPadding, slot);
+    if (page < 0) {
+        std::cerr << "[OpenGLGlyphCache] no room for U+" << std::hex << codepoint << std::dec
+                  << " (every page is in use this frame)" << std::endl;
+        return nullptr;
+    }
+
+    Page& target = m_pages[page];
+    upload(target, slot, m_bitmap);
+    target.codepoints.push_back(codepoint);
+    target.lastUsed = m_frame;
+
+    auto& gm = glyph.metrics;
+    gm.atlasX = slot.x + kPadding;
+    gm.atlasY = slot.y + kPadding;
+    gm.u0 = float(gm.atlasX) / m_pageSize;
+    gm.v0 = float(gm.atlasY) / m_pageSize;
+    gm.u1 = float(gm.atlasX + gm.width) / m_pageSize;
+    gm.v1 = float(gm.atlasY + gm.height) / m_pageSize;
+    glyph.page = static_cast<uint16_t>(page);
+
+    return &m_glyphs.emplace(codepoint, glyph).first->second;
+}
+
+std::size_t OpenGLGlyphCache::preload(const uint32_t* codepoints, std::size_t count) {
+    std::size_t cached = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (getGlyph(codepoints[i]))
+            ++cached;
+    }
+    return cached;
+}
+
+// ------------------------------------------------------------
+// Page management
+// ------------------------------------------------------------
+int OpenGLGlyphCache::allocate(int width, int height, PackedRect& out) {
+    if (width > m_pageSize || height > m_pageSize)
+        return -1;
+
+    for (std::size_t i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].packer.insert(width, height, out))
+            return static_cast<int>(i);
+    }
+
+    if (m_pages.size() < m_maxPages) {
+        // One byte per texel where it can be swizzled to white + alpha
+        if (m_pages.empty())
+            m_channels = OpenGLTexture::isSwizzleSupported() ? 1 : 4;
+
+        TextureDesc desc;
+        desc.format = m_channels == 1 ? TextureFormat::Alpha8 : TextureFormat::RGBA8;
+
+        Page page;
+        page.texture = std::make_shared<OpenGLTexture>(nullptr, m_pageSize, m_pageSize, m_channels, desc);
+        page.packer.reset(m_pageSize, m_pageSize);
+        page.packer.insert(width, height, out);
+        m_pages.push_back(std::move(page));
+        return static_cast<int>(m_pages.size() - 1);
+    }
+
+    // Least recently used page that no quad of this frame samples
+    std::size_t victim = m_pages.size();
+    for (std::size_t i = 0; i < m_pages.size(); ++i) {
+        if (m_pages[i].lastUsed >= m_frame) continue;
+        if (victim == m_pages.size() || m_pages[i].lastUsed < m_pages[victim].lastUsed)
+            victim = i;
+    }
+    if (victim == m_pages.size())
+        return -1;
+
+    evict(victim);
+    m_pages[victim].packer.insert(width, height, out);
+    return static_cast<int>(victim);
+}
+
+void OpenGLGlyphCache::evict(std::size_t index) {
+    Page& page = m_pages[index];
+    for (uint32_t codepoint : page.codepoints)
+        m_glyphs.erase(codepoint);
+
+    // Stale pixels are overwritten by the padded blocks of new glyphs
+    page.codepoints.clear();
+    page.packer.reset(m_pageSize, m_pageSize);
+    ++m_evictions;
+}
+
+void OpenGLGlyphCache::upload(const Page& page, const PackedRect& slot, const GlyphBitmap& bitmap) {
+    m_scratch.assign(static_cast<std::size_t>(slot.width) * slot.height * m_channels, 0);
+
+    for (int y = 0; y < bitmap.height; ++y) {
+        const uint8_t* src = &bitmap.pixels[static_cast<std::size_t>(y) * bitmap.width];
+        uint8_t* dst = &m_scratch[(static_cast<std::size_t>(y + kPadding) * slot.width + kPadding) * m_channels];
+
+        if (m_channels == 1) {
+            std::copy_n(src, bitmap.width, dst);
+            continue;
+        }
+
+        // White text, glyph in alpha
+        for (int x = 0; x < bitmap.width; ++x, dst += 4) {
+            dst[0] = 255;
+            dst[1] = 255;
+            dst[2] = 255;
+            dst[3] = src[x];
+        }
+    }
+
+    page.texture->update(slot.x, slot.y, slot.width, slot.height, m_scratch.data());
+}
+
+void OpenGLGlyphCache::clear() {
+    m_pages.clear();
+    m_glyphs.clear();
+    m_scratch.clear();
+    m_scratch.shrink_to_fit();
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,56 @@
+#include "retronomicon/graphics/opengl_sampler_cache.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics {
+
+OpenGLSamplerCache::~OpenGLSamplerCache() {
+    release();
+}
+
+bool OpenGLSamplerCache::isSupported() {
+    return GLAD_GL_ARB_sampler_objects != 0;
+}
+
+unsigned int OpenGLSamplerCache::get(const SamplerDesc& desc) {
+    if (!isSupported()) return 0;
+
+    const uint32_t key = desc.getKey();
+    auto it = m_samplers.find(key);
+    if (it != m_samplers.end()) return it->second;
+
+    // The sampler's min filter always allows mips; MAX_LEVEL keeps single-level textures complete
+    TextureDesc sampling;
+    sampling.filter = desc.filter;
+    sampling.wrap = desc.wrap;
+
+    GLuint sampler = 0;
+    glGenSamplers(1, &sampler);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, getGLWrap(sampling));
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, getGLWrap(sampling));
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, getGLMinFilter(sampling, true));
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, getGLMagFilter(sampling));
+
+    if (desc.anisotropy > 1 && GLAD_GL_EXT_texture_filter_anisotropic) {
+        if (m_maxAnisotropy == 0.0f)
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &m_maxAnisotropy);
+        glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT,
+                            std::min(static_cast<float>(desc.anisotropy), std::max(m_maxAnisotropy, 1.0f)));
+    }
+
+    m_samplers.emplace(key, sampler);
+    return sampler;
+}
+
+void OpenGLSamplerCache::release() {
+    auto& state = OpenGLStateCache::get();
+    for (auto& entry : m_samplers) {
+        state.forgetSampler(entry.second);
+        glDeleteSamplers(1, &entry.second);
+    }
+    m_samplers.clear();
+}
+
+} // namespace retronomicon::opengl::graphics
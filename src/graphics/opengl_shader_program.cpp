@@ -0,0 +1,347 @@
+#include "retronomicon/graphics/opengl_shader_program.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace retronomicon::opengl::graphics {
+
+// ------------------------------------------------------------
+// Binary cache helpers
+// ------------------------------------------------------------
+static constexpr uint32_t kBinaryMagic   = 0x42474C52; // "RLGB"
+static constexpr uint32_t kBinaryVersion = 1;
+
+static std::string& cacheDirectory() {
+    static std::string directory;
+    return directory;
+}
+
+static void hashBytes(uint64_t& hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull; // FNV-1a 64-bit prime
+    }
+}
+
+static void hashString(uint64_t& hash, const char* str) {
+    if (!str) str = "";
+    // Include the terminator so "ab"+"c" and "a"+"bc" differ
+    hashBytes(hash, str, std::strlen(str) + 1);
+}
+
+static bool binaryCacheSupported() {
+    if (cacheDirectory().empty() || !GLAD_GL_ARB_get_program_binary)
+        return false;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+static std::string binaryCachePath(const std::string& vertexSrc, const std::string& fragmentSrc) {
+    uint64_t hash = 0xCBF29CE484222325ull; // FNV-1a 64-bit offset basis
+    hashString(hash, vertexSrc.c_str());
+    hashString(hash, fragmentSrc.c_str());
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(cacheDirectory()) / name).string();
+}
+
+// ------------------------------------------------------------
+// Lifetime
+// ------------------------------------------------------------
+OpenGLShaderProgram::~OpenGLShaderProgram() {
+    release();
+}
+
+OpenGLShaderProgram::OpenGLShaderProgram(OpenGLShaderProgram&& other) noexcept
+    : m_program(std::exchange(other.m_program, 0))
+    , m_fromCache(other.m_fromCache)
+    , m_uniforms(std::move(other.m_uniforms))
+    , m_attributes(std::move(other.m_attributes)) {}
+
+OpenGLShaderProgram& OpenGLShaderProgram::operator=(OpenGLShaderProgram&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_program    = std::exchange(other.m_program, 0);
+        m_fromCache  = other.m_fromCache;
+        m_uniforms   = std::move(other.m_uniforms);
+        m_attributes = std::move(other.m_attributes);
+    }
+    return *this;
+}
+
+void OpenGLShaderProgram::setBinaryCacheDirectory(const std::string& directory) {
+    cacheDirectory() = directory;
+}
+
+const std::string& OpenGLShaderProgram::getBinaryCacheDirectory() {
+    return cacheDirectory();
+}
+
+void OpenGLShaderProgram::release() {
+    if (m_program) {
+        OpenGLStateCache::get().forgetProgram(m_program);
+        glDeleteProgram(m_program);
+    }
+
+    m_program = 0;
+    m_fromCache = false;
+    m_uniforms.clear();
+    m_attributes.clear();
+}
+
+// ------------------------------------------------------------
+// Build
+// ------------------------------------------------------------
+void OpenGLShaderProgram::build(const std::string& vertexSrc, const std::string& fragmentSrc) {
+    release();
+
+    const bool useCache = binaryCacheSupported();
+    std::string path;
+
+    if (useCache) {
+        path = binaryCachePath(vertexSrc, fragmentSrc);
+        m_program = loadBinary(path);
+        m_fromCache = m_program != 0;
+    }
+
+    if (!m_program) {
+        m_program = compile(vertexSrc, fragmentSrc);
+        if (useCache)
+            storeBinary(path);
+    }
+
+    reflect();
+}
+
+unsigned int OpenGLShaderProgram::compile(const std::string& vertexSrc, const std::string& fragmentSrc) {
+    auto compileShader = [](GLenum type, const std::string& src) {
+        GLuint shader = glCreateShader(type);
+        const char* text = src.c_str();
+        glShaderSource(shader, 1, &text, nullptr);
+        glCompileShader(shader);
+
+        GLint success;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            char log[512];
+            glGetShaderInfoLog(shader, 512, nullptr, log);
+            glDeleteShader(shader);
+            throw std::runtime_error(std::string("Shader compile error: ") + log);
+        }
+        return shader;
+    };
+
+    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexSrc);
+    GLuint fs = 0;
+    try {
+        fs = compileShader(GL_FRAGMENT_SHADER, fragmentSrc);
+    } catch (...) {
+        glDeleteShader(vs);
+        throw;
+    }
+
+    GLuint prog = glCreateProgram();
+    if (GLAD_GL_ARB_get_program_binary)
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glLinkProgram(prog);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint success;
+    glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    if (!success) {
+        char log[512];
+        glGetProgramInfoLog(prog, 512, nullptr, log);
+        glDeleteProgram(prog);
+        throw std::runtime_error(std::string("Shader link error: ") + log);
+    }
+
+    return prog;
+}
+
+unsigned int OpenGLShaderProgram::loadBinary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return 0;
+
+    uint32_t header[4] = {};
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+        return 0;
+
+    const uint32_t magic = header[0], version = header[1], format = header[2], length = header[3];
+    if (magic != kBinaryMagic || version != kBinaryVersion || length == 0)
+        return 0;
+
+    std::vector<char> blob(length);
+    if (!file.read(blob.data(), length))
+        return 0;
+
+    GLuint prog = glCreateProgram();
+    glProgramBinary(prog, format, blob.data(), static_cast<GLsizei>(length));
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    if (!success) {
+        // Stale or foreign binary: the caller recompiles and overwrites it
+        glDeleteProgram(prog);
+        return 0;
+    }
+
+    return prog;
+}
+
+void OpenGLShaderProgram::storeBinary(const std::string& path) const {
+    GLint length = 0;
+    glGetProgramiv(m_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> blob(length);
+    GLenum format = 0;
+    glGetProgramBinary(m_program, length, nullptr, &format, blob.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[OpenGLShaderProgram] Cannot write program binary: " << path << "\n";
+        return;
+    }
+
+    const uint32_t header[4] = {
+        kBinaryMagic,
+        kBinaryVersion,
+        static_cast<uint32_t>(format),
+        static_cast<uint32_t>(length)
+    };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(blob.data(), length);
+}
+
+// ------------------------------------------------------------
+// Reflection
+// ------------------------------------------------------------
+void OpenGLShaderProgram::reflect() {
+    m_uniforms.clear();
+    m_attributes.clear();
+
+    auto stripArraySuffix = [](std::string name) {
+        auto bracket = name.find('[');
+        if (bracket != std::string::npos)
+            name.erase(bracket);
+        return name;
+    };
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> name(std::max(maxLength, 1));
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_program, i, maxLength, &length, &size, &type, name.data());
+
+        Variable var;
+        var.name     = stripArraySuffix(std::string(name.data(), length));
+        var.location = glGetUniformLocation(m_program, name.data());
+        var.type     = type;
+        var.size     = size;
+
+        // Uniform block members have no location and cannot be set directly
+        if (var.location >= 0)
+            m_uniforms.push_back(std::move(var));
+    }
+
+    glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(m_program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+
+    name.assign(std::max(maxLength, 1), '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(m_program, i, maxLength, &length, &size, &type, name.data());
+
+        Variable var;
+        var.name     = stripArraySuffix(std::string(name.data(), length));
+        var.location = glGetAttribLocation(m_program, name.data());
+        var.type     = type;
+        var.size     = size;
+        m_attributes.push_back(std::move(var));
+    }
+}
+
+OpenGLShaderProgram::UniformId OpenGLShaderProgram::findUniform(const std::string& name) const {
+    for (std::size_t i = 0; i < m_uniforms.size(); ++i) {
+        if (m_uniforms[i].name == name)
+            return static_cast<UniformId>(i);
+    }
+    return InvalidId;
+}
+
+int OpenGLShaderProgram::findAttribute(const std::string& name) const {
+    for (const auto& attr : m_attributes) {
+        if (attr.name == name)
+            return attr.location;
+    }
+    return -1;
+}
+
+// ------------------------------------------------------------
+// Uniform setters
+// ------------------------------------------------------------
+void OpenGLShaderProgram::use() const {
+    OpenGLStateCache::get().useProgram(m_program);
+}
+
+void OpenGLShaderProgram::setInt(UniformId id, int value) const {
+    if (id < 0) return;
+    glUniform1i(m_uniforms[id].location, value);
+}
+
+void OpenGLShaderProgram::setIntArray(UniformId id, const int* values, int count) const {
+    if (id < 0) return;
+    glUniform1iv(m_uniforms[id].location, count, values);
+}
+
+void OpenGLShaderProgram::setFloat(UniformId id, float value) const {
+    if (id < 0) return;
+    glUniform1f(m_uniforms[id].location, value);
+}
+
+void OpenGLShaderProgram::setVec2(UniformId id, float x, float y) const {
+    if (id < 0) return;
+    glUniform2f(m_uniforms[id].location, x, y);
+}
+
+void OpenGLShaderProgram::setVec4(UniformId id, const float* values) const {
+    if (id < 0) return;
+    glUniform4fv(m_uniforms[id].location, 1, values);
+}
+
+void OpenGLShaderProgram::setMat4(UniformId id, const float* values) const {
+    if (id < 0) return;
+    glUniformMatrix4fv(m_uniforms[id].location, 1, GL_FALSE, values);
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,226 @@
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics {
+
+OpenGLStateCache& OpenGLStateCache::get() {
+    static OpenGLStateCache instance;
+    return instance;
+}
+
+OpenGLStateCache::OpenGLStateCache() {
+    invalidate();
+}
+
+void OpenGLStateCache::invalidate() {
+    m_program = Unknown;
+    m_activeUnit = Unknown;
+    for (auto& unit : m_textures)
+        unit.fill(Unknown);
+    m_samplers.fill(Unknown);
+    m_vao = Unknown;
+    m_buffers.fill(Unknown);
+    m_blend = Unknown;
+    m_blendSrc = Unknown;
+    m_blendDst = Unknown;
+    m_viewportKnown = false;
+    m_unpackAlignment = Unknown;
+}
+
+// ------------------------------------------------------------
+// Records the new value and counts the call as issued or elided
+// ------------------------------------------------------------
+bool OpenGLStateCache::changed(unsigned int& shadow, unsigned int value) {
+    if (shadow == value) {
+        ++m_current.elided;
+        return false;
+    }
+    shadow = value;
+    ++m_current.issued;
+    return true;
+}
+
+int OpenGLStateCache::textureSlot(unsigned int target) {
+    switch (target) {
+        case GL_TEXTURE_2D:       return Slot2D;
+        case GL_TEXTURE_2D_ARRAY: return Slot2DArray;
+        default:                  return -1;
+    }
+}
+
+int OpenGLStateCache::bufferSlot(unsigned int target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER:        return BufArray;
+        case GL_PIXEL_PACK_BUFFER:   return BufPixelPack;
+        case GL_PIXEL_UNPACK_BUFFER: return BufPixelUnpack;
+        case GL_COPY_READ_BUFFER:    return BufCopyRead;
+        case GL_COPY_WRITE_BUFFER:   return BufCopyWrite;
+        case GL_UNIFORM_BUFFER:      return BufUniform;
+        default:                     return -1;
+    }
+}
+
+// ------------------------------------------------------------
+// Bindings
+// ------------------------------------------------------------
+void OpenGLStateCache::useProgram(unsigned int program) {
+    if (changed(m_program, program))
+        glUseProgram(program);
+}
+
+void OpenGLStateCache::activeTexture(unsigned int unit) {
+    if (changed(m_activeUnit, unit))
+        glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void OpenGLStateCache::bindTexture(unsigned int target, unsigned int texture) {
+    int slot = textureSlot(target);
+    if (slot < 0 || m_activeUnit >= MaxTextureUnits) {
+        ++m_current.issued;
+        glBindTexture(target, texture);
+        return;
+    }
+
+    if (changed(m_textures[m_activeUnit][slot], texture))
+        glBindTexture(target, texture);
+}
+
+void OpenGLStateCache::bindTexture(unsigned int unit, unsigned int target, unsigned int texture) {
+    int slot = textureSlot(target);
+    if (slot >= 0 && unit < MaxTextureUnits && m_textures[unit][slot] == texture) {
+        ++m_current.elided;
+        return;
+    }
+
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+void OpenGLStateCache::bindSampler(unsigned int unit, unsigned int sampler) {
+    if (unit >= MaxTextureUnits) {
+        ++m_current.issued;
+        glBindSampler(unit, sampler);
+        return;
+    }
+
+    if (changed(m_samplers[unit], sampler))
+        glBindSampler(unit, sampler);
+}
+
+void OpenGLStateCache::bindVertexArray(unsigned int vao) {
+    if (changed(m_vao, vao))
+        glBindVertexArray(vao);
+}
+
+void OpenGLStateCache::bindBuffer(unsigned int target, unsigned int buffer) {
+    int slot = bufferSlot(target);
+    if (slot < 0) {
+        ++m_current.issued;
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if (changed(m_buffers[slot], buffer))
+        glBindBuffer(target, buffer);
+}
+
+// ------------------------------------------------------------
+// Fixed-function state
+// ------------------------------------------------------------
+void OpenGLStateCache::setBlend(bool enabled) {
+    if (!changed(m_blend, enabled ? 1u : 0u)) return;
+
+    if (enabled)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+}
+
+void OpenGLStateCache::blendFunc(unsigned int srcFactor, unsigned int dstFactor) {
+    if (m_blendSrc == srcFactor && m_blendDst == dstFactor) {
+        ++m_current.elided;
+        return;
+    }
+
+    m_blendSrc = srcFactor;
+    m_blendDst = dstFactor;
+    ++m_current.issued;
+    glBlendFunc(srcFactor, dstFactor);
+}
+
+void OpenGLStateCache::viewport(int x, int y, int width, int height) {
+    const std::array<int, 4> value{ x, y, width, height };
+    if (m_viewportKnown && m_viewport == value) {
+        ++m_current.elided;
+        return;
+    }
+
+    m_viewport = value;
+    m_viewportKnown = true;
+    ++m_current.issued;
+    glViewport(x, y, width, height);
+}
+
+void OpenGLStateCache::unpackAlignment(int alignment) {
+    if (changed(m_unpackAlignment, static_cast<unsigned int>(alignment)))
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+// ------------------------------------------------------------
+// Object deletion: GL resets bindings of deleted objects to 0
+// ------------------------------------------------------------
+void OpenGLStateCache::forgetTexture(unsigned int texture) {
+    if (texture == 0) return;
+
+    for (auto& unit : m_textures) {
+        for (auto& bound : unit) {
+            if (bound == texture) bound = 0;
+        }
+    }
+}
+
+void OpenGLStateCache::forgetBuffer(unsigned int buffer) {
+    if (buffer == 0) return;
+
+    for (auto& bound : m_buffers) {
+        if (bound == buffer) bound = 0;
+    }
+}
+
+void OpenGLStateCache::forgetVertexArray(unsigned int vao) {
+    if (vao != 0 && m_vao == vao)
+        m_vao = 0;
+}
+
+void OpenGLStateCache::forgetProgram(unsigned int program) {
+    // A deleted program stays current until replaced, but its name may be reused
+    if (program != 0 && m_program == program)
+        m_program = Unknown;
+}
+
+void OpenGLStateCache::forgetSampler(unsigned int sampler) {
+    if (sampler == 0) return;
+
+    for (auto& bound : m_samplers) {
+        if (bound == sampler) bound = 0;
+    }
+}
+
+unsigned int OpenGLStateCache::getBoundTexture(unsigned int unit, unsigned int target) const {
+    int slot = textureSlot(target);
+    if (slot < 0 || unit >= MaxTextureUnits || m_textures[unit][slot] == Unknown)
+        return 0;
+    return m_textures[unit][slot];
+}
+
+// ------------------------------------------------------------
+// Frame bookkeeping
+// ------------------------------------------------------------
+void OpenGLStateCache::nextFrame() {
+    m_lastFrame = m_current;
+    m_current = {};
+    m_frameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace retronomicon::opengl::graphics
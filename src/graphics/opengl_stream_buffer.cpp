@@ -0,0 +1,149 @@
+#include "retronomicon/graphics/opengl_stream_buffer.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <glad/gl.h>
+#include <algorithm>
+#include <iostream>
+
+namespace retronomicon::opengl::graphics {
+
+static inline std::size_t alignUp(std::size_t value, std::size_t alignment) {
+    if (alignment <= 1) return value;
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+OpenGLStreamBuffer::OpenGLStreamBuffer(std::size_t capacity)
+    : m_capacity(std::max<std::size_t>(capacity, 1)) {}
+
+OpenGLStreamBuffer::~OpenGLStreamBuffer() {
+    shutdown();
+}
+
+void OpenGLStreamBuffer::init() {
+    glGenBuffers(1, &m_buffer);
+    OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    if (GLAD_GL_ARB_buffer_storage && GLAD_GL_ARB_sync) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, m_capacity, nullptr, flags);
+        m_mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, m_capacity, flags);
+        if (!m_mapped)
+            std::cerr << "[OpenGLStreamBuffer] Persistent mapping failed, falling back to orphaning\n";
+    }
+
+    if (!m_mapped) {
+        if (GLAD_GL_ARB_buffer_storage && GLAD_GL_ARB_sync) {
+            // Immutable storage cannot be orphaned; start over with a mutable buffer
+            OpenGLStateCache::get().forgetBuffer(m_buffer);
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        }
+        glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+        m_staging.resize(m_capacity);
+    }
+
+    m_head = 0;
+    m_fenceStart = 0;
+}
+
+void OpenGLStreamBuffer::shutdown() {
+    for (auto& region : m_fences)
+        glDeleteSync(static_cast<GLsync>(region.sync));
+    m_fences.clear();
+
+    if (m_buffer) {
+        if (m_mapped) {
+            OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        OpenGLStateCache::get().forgetBuffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+    }
+
+    m_buffer = 0;
+    m_mapped = nullptr;
+    m_staging.clear();
+    m_staging.shrink_to_fit();
+    m_head = 0;
+    m_fenceStart = 0;
+}
+
+OpenGLStreamBuffer::Allocation OpenGLStreamBuffer::allocate(std::size_t size, std::size_t alignment) {
+    if (!m_buffer || size == 0 || size > m_capacity)
+        return {};
+
+    std::size_t offset = alignUp(m_head, alignment);
+
+    if (offset + size > m_capacity) {
+        if (m_mapped) {
+            // Everything written this lap must be fenced before it is reused
+            fence();
+        } else {
+            // Orphan: the driver hands out fresh storage, in-flight draws keep the old one
+            OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+        }
+        offset = 0;
+        m_fenceStart = 0;
+    }
+
+    if (m_mapped)
+        waitForRange(offset, offset + size);
+
+    m_head = offset + size;
+
+    unsigned char* base = m_mapped ? static_cast<unsigned char*>(m_mapped) : m_staging.data();
+    return { base + offset, offset, size };
+}
+
+void OpenGLStreamBuffer::commit(const Allocation& allocation, std::size_t usedBytes) {
+    if (!allocation.data) return;
+
+    usedBytes = std::min(usedBytes, allocation.size);
+
+    // Give the unused tail back if nothing was allocated after this region
+    if (m_head == allocation.offset + allocation.size)
+        m_head = allocation.offset + usedBytes;
+
+    if (!m_mapped && usedBytes > 0) {
+        OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, allocation.offset, usedBytes, allocation.data);
+    }
+}
+
+void OpenGLStreamBuffer::fence() {
+    if (!m_mapped || m_head == m_fenceStart) return;
+
+    GLsync sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_fences.push_back({ sync, m_fenceStart, m_head });
+    m_fenceStart = m_head;
+}
+
+void OpenGLStreamBuffer::waitForRange(std::size_t begin, std::size_t end) {
+    // Fences complete in submission order, so waiting on the newest
+    // overlapping one also retires every older fence.
+    std::size_t last = m_fences.size();
+    for (std::size_t i = 0; i < m_fences.size(); ++i) {
+        const FencedRegion& region = m_fences[i];
+        if (region.begin < end && begin < region.end)
+            last = i;
+    }
+    if (last == m_fences.size()) return;
+
+    GLsync sync = static_cast<GLsync>(m_fences[last].sync);
+    GLenum status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        ++m_stalls;
+        do {
+            status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+
+    for (std::size_t i = 0; i <= last; ++i) {
+        glDeleteSync(static_cast<GLsync>(m_fences.front().sync));
+        m_fences.pop_front();
+    }
+}
+
+} // namespace retronomicon::opengl::graphics
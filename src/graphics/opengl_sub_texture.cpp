@@ -0,0 +1,24 @@
+#include "retronomicon/graphics/opengl_sub_texture.h"
+
+namespace retronomicon::opengl::graphics {
+
+OpenGLSubTexture::OpenGLSubTexture(std::shared_ptr<OpenGLTexture> page,
+                                   int pageIndex,
+                                   const PackedRect& rect)
+: m_page(std::move(page))
+, m_pageIndex(pageIndex)
+, m_rect(rect)
+{
+    const float pageW = static_cast<float>(m_page->getWidth());
+    const float pageH = static_cast<float>(m_page->getHeight());
+
+    m_u0 = rect.x / pageW;
+    m_v0 = rect.y / pageH;
+    m_u1 = (rect.x + rect.width) / pageW;
+    m_v1 = (rect.y + rect.height) / pageH;
+}
+
+void OpenGLSubTexture::bind() const { m_page->bind(); }
+void OpenGLSubTexture::unbind() const { m_page->unbind(); }
+
+} // namespace retronomicon::opengl::graphics
@@ -1,65 +1,133 @@
 #include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
 #include <glad/gl.h>
+#include <cstring>
+#include <iostream>
 #include <stdexcept>
+#include <vector>
 
 namespace retronomicon::opengl::graphics {
 
 // ------------------------------------------------------------
-// Shared internal function for both constructors
+// Estimated GPU footprint over the allocated levels
 // ------------------------------------------------------------
-static inline void uploadTexture(
+// Drivers pad RGB8 to 4 bytes; only R8 is stored smaller.
+static std::size_t estimateBytes(int width, int height, int levels, int texelBytes = 4) {
+    std::size_t bytes = 0;
+    for (int level = 0; level < levels; ++level)
+        bytes += static_cast<std::size_t>(getMipSize(width, level)) * getMipSize(height, level) * texelBytes;
+    return bytes;
+}
+
+static int getTexelBytes(const TextureDesc& desc, int channels) {
+    return getGLInternalFormat(desc, channels) == GL_R8 ? 1 : 4;
+}
+
+// Client pixel layout for a channel count
+static GLenum getDataFormat(int channels) {
+    return getGLDataFormat(channels);
+}
+
+// Expands single-channel storage of the bound GL_TEXTURE_2D when sampled
+static void applySwizzle(const TextureDesc& desc, int channels) {
+    if (getGLInternalFormat(desc, channels) != GL_R8 || !OpenGLTexture::isSwizzleSupported())
+        return;
+
+    static const GLint kGray[4]  = { GL_RED, GL_RED, GL_RED, GL_ONE };
+    static const GLint kAlpha[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA,
+                     desc.format == TextureFormat::Alpha8 ? kAlpha : kGray);
+}
+
+bool OpenGLTexture::isSwizzleSupported() {
+    return GLAD_GL_ARB_texture_swizzle != 0;
+}
+
+// Sampling state of the bound GL_TEXTURE_2D
+static void applySampling(const TextureDesc& desc, int levels) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, getGLWrap(desc));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, getGLWrap(desc));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getGLMinFilter(desc, levels > 1));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, getGLMagFilter(desc));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
+
+// ------------------------------------------------------------
+// Shared internal function for the constructors and the uploader
+// ------------------------------------------------------------
+int OpenGLTexture::upload(
     unsigned int& id,
     const uint8_t* pixels,
     int width,
     int height,
-    int channels
+    int channels,
+    const TextureDesc& desc,
+    bool fromUnpackBuffer
 ){
     if (width <= 0 || height <= 0)
         throw std::runtime_error("OpenGLTexture: invalid dimensions");
 
-    GLint internalFormat = (channels == 4) ? GL_RGBA8 : GL_RGB8;
-    GLenum dataFormat    = (channels == 4) ? GL_RGBA  : GL_RGB;
+    // Only a generated chain can be filled from a single image
+    const int levels = desc.mips == MipPolicy::Generate ? getFullMipCount(width, height) : 1;
+    const GLenum internalFormat = getGLInternalFormat(desc, channels);
+    const GLenum dataFormat     = getDataFormat(channels);
+    const bool hasData          = pixels != nullptr || fromUnpackBuffer;
 
     glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_2D, id);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        internalFormat,
-        width,
-        height,
-        0,
-        dataFormat,
-        GL_UNSIGNED_BYTE,
-        pixels
-    );
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(GL_TEXTURE_2D, id);
+
+    applySampling(desc, levels);
+    applySwizzle(desc, channels);
+    state.unpackAlignment(1);
+
+    if (GLAD_GL_ARB_texture_storage) {
+        glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+        if (hasData) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                            dataFormat, GL_UNSIGNED_BYTE, pixels);
+        }
+    } else {
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            static_cast<GLint>(internalFormat),
+            width,
+            height,
+            0,
+            dataFormat,
+            GL_UNSIGNED_BYTE,
+            pixels
+        );
+    }
+
+    if (levels > 1 && hasData)
+        glGenerateMipmap(GL_TEXTURE_2D);
 
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return levels;
 }
 
 // ------------------------------------------------------------
 // Constructor: from ImageAsset (original)
 // ------------------------------------------------------------
-OpenGLTexture::OpenGLTexture(std::shared_ptr<ImageAsset> image)
+OpenGLTexture::OpenGLTexture(std::shared_ptr<ImageAsset> image, const TextureDesc& desc)
 : m_textureId(0)
 , m_width(image->getWidth())
 , m_height(image->getHeight())
+, m_source(image)
+, m_desc(desc)
+, m_channels(image->getChannels())
 {
-    uploadTexture(
+    m_mipLevels = upload(
         m_textureId,
         image->getPixels().data(),
         m_width,
         m_height,
-        image->getChannels()
+        image->getChannels(),
+        m_desc
     );
+    m_byteSize = estimateBytes(m_width, m_height, m_mipLevels, getTexelBytes(m_desc, m_channels));
+    touch();
 }
 
 // ------------------------------------------------------------
@@ -69,30 +137,306 @@ OpenGLTexture::OpenGLTexture(
     const uint8_t* pixels,
     int width,
     int height,
-    int channels
+    int channels,
+    const TextureDesc& desc
 )
 : m_textureId(0)
 , m_width(width)
 , m_height(height)
+, m_desc(desc)
+, m_channels(channels)
 {
-    uploadTexture(
+    m_mipLevels = upload(
         m_textureId,
         pixels,
         width,
         height,
-        channels
+        channels,
+        m_desc
     );
+    m_byteSize = estimateBytes(width, height, m_mipLevels, getTexelBytes(m_desc, channels));
+    touch();
+}
+
+// ------------------------------------------------------------
+// Constructor: placeholder until uploaded asynchronously
+// ------------------------------------------------------------
+OpenGLTexture::OpenGLTexture(std::shared_ptr<OpenGLTexture> placeholder, const TextureDesc& desc)
+: m_textureId(0)
+, m_width(placeholder->getWidth())
+, m_height(placeholder->getHeight())
+, m_placeholder(std::move(placeholder))
+, m_placeholderId(m_placeholder->getId())
+, m_desc(desc)
+{}
+
+// ------------------------------------------------------------
+// Constructor: from a KTX2 image (compressed, with mips)
+// ------------------------------------------------------------
+static GLenum compressedInternalFormat(CompressedFormat format) {
+    switch (format) {
+        case CompressedFormat::BC1:       return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case CompressedFormat::BC3:       return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case CompressedFormat::BC7:       return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+        case CompressedFormat::ETC2_RGB:  return GL_COMPRESSED_RGB8_ETC2;
+        case CompressedFormat::ETC2_RGBA: return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case CompressedFormat::RGBA8:     break;
+    }
+    return GL_RGBA8;
+}
+
+bool OpenGLTexture::isFormatSupported(CompressedFormat format) {
+    switch (format) {
+        case CompressedFormat::RGBA8:     return true;
+        case CompressedFormat::BC1:
+        case CompressedFormat::BC3:       return GLAD_GL_EXT_texture_compression_s3tc != 0;
+        case CompressedFormat::BC7:       return GLAD_GL_ARB_texture_compression_bptc != 0;
+        case CompressedFormat::ETC2_RGB:
+        case CompressedFormat::ETC2_RGBA: return GLAD_GL_ARB_ES3_compatibility != 0;
+    }
+    return false;
+}
+
+OpenGLTexture::OpenGLTexture(const Ktx2Image& image, const TextureDesc& desc)
+: m_textureId(0)
+, m_width(image.width)
+, m_height(image.height)
+, m_desc(desc)
+{
+    if (image.width <= 0 || image.height <= 0 || image.levels.empty())
+        throw std::runtime_error("OpenGLTexture: invalid KTX2 image");
+
+    const bool native = isFormatSupported(image.format);
+    const bool compressed = native && isBlockFormat(image.format);
+    m_format = native ? image.format : CompressedFormat::RGBA8;
+    m_desc.format = TextureFormat::RGBA8;
+
+    // Levels taken from the file, and total levels allocated
+    int fileLevels = 1;
+    if (desc.mips == MipPolicy::Precomputed || (desc.mips == MipPolicy::Generate && compressed))
+        fileLevels = static_cast<int>(image.levels.size());
+    m_mipLevels = (desc.mips == MipPolicy::Generate && !compressed)
+                ? getFullMipCount(m_width, m_height) : fileLevels;
+
+    const GLenum internalFormat = compressed ? compressedInternalFormat(image.format) : GL_RGBA8;
+    const bool immutable = GLAD_GL_ARB_texture_storage != 0;
+
+    glGenTextures(1, &m_textureId);
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(GL_TEXTURE_2D, m_textureId);
+
+    applySampling(m_desc, m_mipLevels);
+    state.unpackAlignment(1);
+
+    if (immutable)
+        glTexStorage2D(GL_TEXTURE_2D, m_mipLevels, internalFormat, m_width, m_height);
+
+    std::vector<uint8_t> decoded;
+    for (int level = 0; level < fileLevels; ++level) {
+        const int w = getMipSize(image.width, level);
+        const int h = getMipSize(image.height, level);
+        const auto& data = image.levels[level];
+
+        if (compressed) {
+            if (immutable) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w, h, internalFormat,
+                                          static_cast<GLsizei>(data.size()), data.data());
+            } else {
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, w, h, 0,
+                                       static_cast<GLsizei>(data.size()), data.data());
+            }
+            m_byteSize += data.size();
+            continue;
+        }
+
+        const uint8_t* pixels = data.data();
+        if (isBlockFormat(image.format)) {
+            decoded.resize(static_cast<std::size_t>(w) * h * 4);
+            decodeImage(image.format, data.data(), w, h, decoded.data());
+            pixels = decoded.data();
+        }
+
+        if (immutable)
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    if (!compressed) {
+        if (m_mipLevels > fileLevels)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        m_byteSize = estimateBytes(m_width, m_height, m_mipLevels);
+    }
+
+    touch();
+}
+
+void OpenGLTexture::makeResident(unsigned int id, int width, int height, int channels, int mipLevels,
+                                 std::shared_ptr<ImageAsset> source) {
+    m_textureId = id;
+    m_width = width;
+    m_height = height;
+    m_channels = channels;
+    m_mipLevels = mipLevels;
+    m_byteSize = estimateBytes(width, height, mipLevels, getTexelBytes(m_desc, channels));
+    m_source = std::move(source);
+    m_placeholder.reset();
+    m_placeholderId = 0;
+    touch();
+}
+
+// ------------------------------------------------------------
+// Dynamic updates
+// ------------------------------------------------------------
+bool OpenGLTexture::canUpdate() const {
+    if (m_textureId == 0) {
+        std::cerr << "[OpenGLTexture] update: texture is not resident" << std::endl;
+        return false;
+    }
+    if (m_format != CompressedFormat::RGBA8) {
+        std::cerr << "[OpenGLTexture] update: compressed textures cannot be updated" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void OpenGLTexture::uploadRect(int x, int y, int width, int height,
+                               const uint8_t* pixels, int stride, OpenGLStreamBuffer* staging) {
+    const std::size_t rowBytes = static_cast<std::size_t>(width) * m_channels;
+    const std::size_t bytes = rowBytes * height;
+    const GLenum format = getDataFormat(m_channels);
+
+    if (staging && staging->getBuffer() != 0 && bytes <= staging->getCapacity()) {
+        OpenGLStreamBuffer::Allocation allocation = staging->allocate(bytes, 4);
+        if (allocation.data) {
+            auto* dst = static_cast<uint8_t*>(allocation.data);
+            for (int row = 0; row < height; ++row)
+                std::memcpy(dst + row * rowBytes, pixels + static_cast<std::size_t>(row) * stride, rowBytes);
+            staging->commit(allocation, bytes);
+
+            auto& state = OpenGLStateCache::get();
+            state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, staging->getBuffer());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, GL_UNSIGNED_BYTE,
+                            reinterpret_cast<const void*>(allocation.offset));
+            state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            return;
+        }
+    }
+
+    if (stride % m_channels == 0) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / m_channels);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        return;
+    }
+
+    // Rows not a whole number of pixels apart: one row at a time
+    for (int row = 0; row < height; ++row) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + row, width, 1, format, GL_UNSIGNED_BYTE,
+                        pixels + static_cast<std::size_t>(row) * stride);
+    }
+}
+
+bool OpenGLTexture::update(int x, int y, int width, int height,
+                           const uint8_t* pixels, int stride, OpenGLStreamBuffer* staging) {
+    if (!canUpdate()) return false;
+    if (!pixels || width <= 0 || height <= 0 || x < 0 || y < 0 ||
+        x + width > m_width || y + height > m_height) {
+        std::cerr << "[OpenGLTexture] update: rectangle out of bounds" << std::endl;
+        return false;
+    }
+
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(GL_TEXTURE_2D, m_textureId);
+    state.unpackAlignment(1);
+    uploadRect(x, y, width, height, pixels, stride > 0 ? stride : width * m_channels, staging);
+
+    if (m_desc.mips == MipPolicy::Generate && m_mipLevels > 1)
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+    // The GPU copy no longer matches the source image
+    m_source.reset();
+    m_modified = true;
+    return true;
+}
+
+bool OpenGLTexture::update(DirtyRegion& region, const uint8_t* pixels, int stride,
+                           OpenGLStreamBuffer* staging) {
+    if (region.getWidth() != m_width || region.getHeight() != m_height) {
+        std::cerr << "[OpenGLTexture] update: dirty region size does not match the texture" << std::endl;
+        return false;
+    }
+    if (region.empty()) return true;
+    if (!canUpdate() || !pixels) return false;
+
+    if (stride <= 0) stride = m_width * m_channels;
+
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(GL_TEXTURE_2D, m_textureId);
+    state.unpackAlignment(1);
+    for (const auto& rect : region.getRects()) {
+        const uint8_t* first = pixels + static_cast<std::size_t>(rect.y) * stride
+                                      + static_cast<std::size_t>(rect.x) * m_channels;
+        uploadRect(rect.x, rect.y, rect.width, rect.height, first, stride, staging);
+    }
+    region.clear();
+
+    if (m_desc.mips == MipPolicy::Generate && m_mipLevels > 1)
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+    m_source.reset();
+    m_modified = true;
+    return true;
+}
+
+// ------------------------------------------------------------
+// Residency
+// ------------------------------------------------------------
+void OpenGLTexture::touch() const noexcept {
+    m_lastUsedFrame.store(OpenGLStateCache::get().getFrameIndex(), std::memory_order_relaxed);
+    if (m_evicted.load(std::memory_order_acquire))
+        m_restoreRequested.store(true, std::memory_order_relaxed);
+}
+
+bool OpenGLTexture::evict() {
+    if (!m_source || m_textureId == 0) return false;
+
+    OpenGLStateCache::get().forgetTexture(m_textureId);
+    glDeleteTextures(1, &m_textureId);
+    m_textureId = 0;
+    m_evicted.store(true, std::memory_order_release);
+    return true;
+}
+
+void OpenGLTexture::restore() {
+    if (!m_evicted.load(std::memory_order_acquire)) return;
+
+    upload(m_textureId, m_source->getPixels().data(), m_width, m_height, m_source->getChannels(), m_desc);
+    m_evicted.store(false, std::memory_order_release);
+    m_restoreRequested.store(false, std::memory_order_relaxed);
+    ++m_restores;
 }
 
 OpenGLTexture::~OpenGLTexture() {
-    if (m_textureId != 0)
+    if (m_textureId != 0) {
+        OpenGLStateCache::get().forgetTexture(m_textureId);
         glDeleteTextures(1, &m_textureId);
+    }
 }
 
 int OpenGLTexture::getWidth() const { return m_width; }
 int OpenGLTexture::getHeight() const { return m_height; }
 
-void OpenGLTexture::bind() const { glBindTexture(GL_TEXTURE_2D, m_textureId); }
-void OpenGLTexture::unbind() const { glBindTexture(GL_TEXTURE_2D, 0); }
+void OpenGLTexture::bind() const {
+    touch();
+
+    // bind() runs on the render thread, where restoring is allowed; the
+    // texture's observable state does not change, only its residency
+    if (m_evicted.load(std::memory_order_acquire))
+        const_cast<OpenGLTexture*>(this)->restore();
+
+    OpenGLStateCache::get().bindTexture(GL_TEXTURE_2D, getId());
+}
+void OpenGLTexture::unbind() const { OpenGLStateCache::get().bindTexture(GL_TEXTURE_2D, 0); }
 
 } // namespace retronomicon::opengl::graphics
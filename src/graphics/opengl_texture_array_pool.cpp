@@ -0,0 +1,140 @@
+#include "retronomicon/graphics/opengl_texture_array_pool.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <iostream>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics {
+
+// ------------------------------------------------------------
+// OpenGLArrayTexture
+// ------------------------------------------------------------
+OpenGLArrayTexture::OpenGLArrayTexture(std::shared_ptr<OpenGLTextureArrayPool> pool, int layer)
+: m_pool(std::move(pool))
+, m_layer(layer)
+{}
+
+OpenGLArrayTexture::~OpenGLArrayTexture() {
+    if (m_pool) m_pool->release(m_layer);
+}
+
+int OpenGLArrayTexture::getWidth() const { return m_pool->getWidth(); }
+int OpenGLArrayTexture::getHeight() const { return m_pool->getHeight(); }
+
+void OpenGLArrayTexture::bind() const {
+    OpenGLStateCache::get().bindTexture(GL_TEXTURE_2D_ARRAY, m_pool->getId());
+}
+
+void OpenGLArrayTexture::unbind() const {
+    OpenGLStateCache::get().bindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// ------------------------------------------------------------
+// OpenGLTextureArrayPool
+// ------------------------------------------------------------
+OpenGLTextureArrayPool::OpenGLTextureArrayPool(int width, int height, int channels, int initialLayers)
+: m_width(width)
+, m_height(height)
+, m_channels(channels)
+, m_initialLayers(std::max(initialLayers, 1))
+{}
+
+OpenGLTextureArrayPool::~OpenGLTextureArrayPool() {
+    if (m_textureId != 0) {
+        OpenGLStateCache::get().forgetTexture(m_textureId);
+        glDeleteTextures(1, &m_textureId);
+    }
+}
+
+std::shared_ptr<OpenGLArrayTexture> OpenGLTextureArrayPool::add(const uint8_t* pixels) {
+    if (!pixels) return nullptr;
+
+    int layer;
+    if (!m_freeLayers.empty()) {
+        layer = m_freeLayers.back();
+        m_freeLayers.pop_back();
+    } else {
+        if (m_nextLayer == m_capacity && !grow(m_capacity == 0 ? m_initialLayers : m_capacity * 2))
+            return nullptr;
+        layer = m_nextLayer++;
+    }
+
+    const GLenum dataFormat = (m_channels == 4) ? GL_RGBA : GL_RGB;
+
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(GL_TEXTURE_2D_ARRAY, m_textureId);
+    state.unpackAlignment(1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0,
+                    0, 0, layer,
+                    m_width, m_height, 1,
+                    dataFormat, GL_UNSIGNED_BYTE, pixels);
+
+    return std::make_shared<OpenGLArrayTexture>(shared_from_this(), layer);
+}
+
+void OpenGLTextureArrayPool::release(int layer) {
+    m_freeLayers.push_back(layer);
+}
+
+bool OpenGLTextureArrayPool::grow(int capacity) {
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    capacity = std::min(capacity, static_cast<int>(maxLayers));
+
+    if (capacity <= m_capacity) {
+        std::cerr << "[OpenGLTextureArrayPool] Layer limit reached (" << maxLayers << ")\n";
+        return false;
+    }
+
+    const GLint internalFormat = (m_channels == 4) ? GL_RGBA8 : GL_RGB8;
+    const GLenum dataFormat    = (m_channels == 4) ? GL_RGBA  : GL_RGB;
+
+    auto& state = OpenGLStateCache::get();
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    state.bindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Single level: keeps the array complete under a mipmapping sampler
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat,
+                 m_width, m_height, capacity, 0,
+                 dataFormat, GL_UNSIGNED_BYTE, nullptr);
+
+    // Carry the used layers over to the new storage on the GPU
+    if (m_textureId != 0 && m_nextLayer > 0) {
+        if (GLAD_GL_ARB_copy_image) {
+            glCopyImageSubData(m_textureId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                               texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                               m_width, m_height, m_nextLayer);
+        } else {
+            GLuint fbo = 0;
+            glGenFramebuffers(1, &fbo);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+            for (int layer = 0; layer < m_nextLayer; ++layer) {
+                glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                          m_textureId, 0, layer);
+                glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                                    0, 0, m_width, m_height);
+            }
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &fbo);
+        }
+    }
+
+    if (m_textureId != 0) {
+        state.forgetTexture(m_textureId);
+        glDeleteTextures(1, &m_textureId);
+    }
+
+    m_textureId = texture;
+    m_capacity = capacity;
+    return true;
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,81 @@
+#include "retronomicon/graphics/opengl_texture_atlas.h"
+
+#include <algorithm>
+
+namespace retronomicon::opengl::graphics {
+
+OpenGLTextureAtlas::OpenGLTextureAtlas(int pageSize, int padding, TextureFilter filter)
+    : m_pageSize(std::max(pageSize, 1)), m_padding(std::max(padding, 0)) {
+    m_pageDesc.filter = filter;
+    m_pageDesc.format = TextureFormat::RGBA8;
+}
+
+bool OpenGLTextureAtlas::fits(int width, int height) const noexcept {
+    return width > 0 && height > 0 &&
+           width + 2 * m_padding <= m_pageSize &&
+           height + 2 * m_padding <= m_pageSize;
+}
+
+std::shared_ptr<OpenGLSubTexture> OpenGLTextureAtlas::add(const uint8_t* pixels,
+                                                          int width,
+                                                          int height,
+                                                          int channels) {
+    if (!pixels || !fits(width, height) || (channels != 3 && channels != 4))
+        return nullptr;
+
+    const int paddedW = width + 2 * m_padding;
+    const int paddedH = height + 2 * m_padding;
+
+    PackedRect slot;
+    std::size_t pageIndex = 0;
+    for (; pageIndex < m_pages.size(); ++pageIndex) {
+        if (m_pages[pageIndex].packer.insert(paddedW, paddedH, slot))
+            break;
+    }
+
+    if (pageIndex == m_pages.size()) {
+        Page page;
+        page.texture = std::make_shared<OpenGLTexture>(nullptr, m_pageSize, m_pageSize, 4, m_pageDesc);
+        page.packer.reset(m_pageSize, m_pageSize);
+        page.packer.insert(paddedW, paddedH, slot);
+        m_pages.push_back(std::move(page));
+    }
+
+    upload(m_pages[pageIndex], slot, pixels, width, height, channels);
+
+    PackedRect inner{ slot.x + m_padding, slot.y + m_padding, width, height };
+    return std::make_shared<OpenGLSubTexture>(m_pages[pageIndex].texture,
+                                              static_cast<int>(pageIndex), inner);
+}
+
+// ------------------------------------------------------------
+// Copies the image into an RGBA block with clamped-edge padding
+// ------------------------------------------------------------
+void OpenGLTextureAtlas::upload(const Page& page, const PackedRect& slot,
+                                const uint8_t* pixels, int width, int height, int channels) {
+    m_scratch.resize(static_cast<std::size_t>(slot.width) * slot.height * 4);
+
+    for (int y = 0; y < slot.height; ++y) {
+        const int srcY = std::clamp(y - m_padding, 0, height - 1);
+        const uint8_t* srcRow = pixels + static_cast<std::size_t>(srcY) * width * channels;
+        uint8_t* dst = &m_scratch[static_cast<std::size_t>(y) * slot.width * 4];
+
+        for (int x = 0; x < slot.width; ++x, dst += 4) {
+            const uint8_t* src = srcRow + std::clamp(x - m_padding, 0, width - 1) * channels;
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = channels == 4 ? src[3] : 255;
+        }
+    }
+
+    page.texture->update(slot.x, slot.y, slot.width, slot.height, m_scratch.data());
+}
+
+void OpenGLTextureAtlas::clear() {
+    m_pages.clear();
+    m_scratch.clear();
+    m_scratch.shrink_to_fit();
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,50 @@
+#include "retronomicon/graphics/opengl_texture_desc.h"
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics {
+
+int getFullMipCount(int width, int height) noexcept {
+    int levels = 1;
+    for (int size = width > height ? width : height; size > 1; size >>= 1)
+        ++levels;
+    return levels;
+}
+
+int getGLMinFilter(const TextureDesc& desc, bool mipmapped) noexcept {
+    if (desc.filter == TextureFilter::Nearest)
+        return mipmapped ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+    return mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+}
+
+int getGLMagFilter(const TextureDesc& desc) noexcept {
+    return desc.filter == TextureFilter::Nearest ? GL_NEAREST : GL_LINEAR;
+}
+
+int getGLWrap(const TextureDesc& desc) noexcept {
+    switch (desc.wrap) {
+        case TextureWrap::Repeat:         return GL_REPEAT;
+        case TextureWrap::MirroredRepeat: return GL_MIRRORED_REPEAT;
+        case TextureWrap::ClampToEdge:    break;
+    }
+    return GL_CLAMP_TO_EDGE;
+}
+
+unsigned int getGLInternalFormat(const TextureDesc& desc, int channels) noexcept {
+    switch (desc.format) {
+        case TextureFormat::RGBA8:        return GL_RGBA8;
+        case TextureFormat::RGB8:         return GL_RGB8;
+        case TextureFormat::SRGB8_ALPHA8: return GL_SRGB8_ALPHA8;
+        case TextureFormat::R8:
+        case TextureFormat::Alpha8:       return GL_R8;
+        case TextureFormat::Auto:         break;
+    }
+    if (channels == 1) return GL_R8;
+    return channels == 4 ? GL_RGBA8 : GL_RGB8;
+}
+
+unsigned int getGLDataFormat(int channels) noexcept {
+    if (channels == 1) return GL_RED;
+    return channels == 4 ? GL_RGBA : GL_RGB;
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,244 @@
+#include "retronomicon/graphics/opengl_texture_uploader.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics {
+
+// Idle staging buffers kept for reuse
+static constexpr std::size_t kMaxIdleStaging = 4;
+
+OpenGLTextureUploader::OpenGLTextureUploader(std::size_t workers) {
+    workers = std::max<std::size_t>(workers, 1);
+    m_workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+        m_workers.emplace_back(&OpenGLTextureUploader::workerMain, this);
+}
+
+OpenGLTextureUploader::~OpenGLTextureUploader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+
+    auto& state = OpenGLStateCache::get();
+    for (auto& transfer : m_transfers) {
+        if (transfer.fence) glDeleteSync(static_cast<GLsync>(transfer.fence));
+        state.forgetTexture(transfer.textureId);
+        glDeleteTextures(1, &transfer.textureId);
+        state.forgetBuffer(transfer.staging.buffer);
+        glDeleteBuffers(1, &transfer.staging.buffer);
+    }
+    for (auto& staging : m_idleStaging) {
+        state.forgetBuffer(staging.buffer);
+        glDeleteBuffers(1, &staging.buffer);
+    }
+}
+
+std::shared_ptr<OpenGLTexture> OpenGLTextureUploader::enqueue(std::shared_ptr<ImageAsset> image,
+                                                              const TextureDesc& desc) {
+    if (!image) return nullptr;
+
+    if (!m_placeholder) {
+        const uint8_t transparent[4] = { 0, 0, 0, 0 };
+        m_placeholder = std::make_shared<OpenGLTexture>(transparent, 1, 1, 4);
+    }
+
+    auto texture = std::make_shared<OpenGLTexture>(m_placeholder, desc);
+
+    auto job = std::make_unique<Job>();
+    job->texture = texture;
+    job->image = std::move(image);
+    job->desc = desc;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+    return texture;
+}
+
+std::size_t OpenGLTextureUploader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queued.size() + m_decoding + m_decoded.size() + m_transfers.size();
+}
+
+// ------------------------------------------------------------
+// Worker threads: decode and convert to RGBA8 (single channel kept as is)
+// ------------------------------------------------------------
+void OpenGLTextureUploader::workerMain() {
+    for (;;) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queued.empty(); });
+            if (m_stopping) return;
+
+            job = std::move(m_queued.front());
+            m_queued.pop_front();
+            ++m_decoding;
+        }
+
+        // Nobody wants the texture any more
+        if (!job->texture.expired()) {
+            ImageAsset& image = *job->image;
+            if (image.isLoaded() || image.load()) {
+                const int channels = image.getChannels();
+                const auto& src = image.getPixels();
+                const std::size_t count = static_cast<std::size_t>(image.getWidth()) * image.getHeight();
+
+                if ((channels == 1 || channels == 3 || channels == 4) && src.size() >= count * channels) {
+                    job->width = image.getWidth();
+                    job->height = image.getHeight();
+                    job->channels = channels == 1 ? 1 : 4;
+                    job->pixels.resize(count * job->channels);
+
+                    if (channels != 3) {
+                        std::memcpy(job->pixels.data(), src.data(), count * channels);
+                    } else {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            job->pixels[i * 4 + 0] = src[i * 3 + 0];
+                            job->pixels[i * 4 + 1] = src[i * 3 + 1];
+                            job->pixels[i * 4 + 2] = src[i * 3 + 2];
+                            job->pixels[i * 4 + 3] = 255;
+                        }
+                    }
+                    job->decoded = true;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_decoding;
+        m_decoded.push_back(std::move(job));
+    }
+}
+
+// ------------------------------------------------------------
+// Render thread
+// ------------------------------------------------------------
+void OpenGLTextureUploader::update(std::size_t byteBudget) {
+    retireTransfers();
+
+    std::size_t staged = 0;
+    while (staged < byteBudget || staged == 0) {
+        std::unique_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty()) break;
+            job = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        if (job->texture.expired()) continue;
+
+        if (!job->decoded) {
+            std::cerr << "[OpenGLTextureUploader] Failed to decode image; keeping placeholder\n";
+            continue;
+        }
+
+        stage(*job);
+        staged += job->pixels.size();
+    }
+}
+
+void OpenGLTextureUploader::retireTransfers() {
+    auto& state = OpenGLStateCache::get();
+
+    auto done = std::remove_if(m_transfers.begin(), m_transfers.end(), [&](Transfer& transfer) {
+        if (transfer.fence) {
+            GLenum status = glClientWaitSync(static_cast<GLsync>(transfer.fence), 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                return false;
+            glDeleteSync(static_cast<GLsync>(transfer.fence));
+        }
+
+        if (auto texture = transfer.texture.lock()) {
+            texture->makeResident(transfer.textureId, transfer.width, transfer.height, transfer.channels,
+                                  transfer.mipLevels, std::move(transfer.source));
+            ++m_completed;
+        } else {
+            state.forgetTexture(transfer.textureId);
+            glDeleteTextures(1, &transfer.textureId);
+        }
+
+        if (m_idleStaging.size() < kMaxIdleStaging) {
+            m_idleStaging.push_back(transfer.staging);
+        } else {
+            state.forgetBuffer(transfer.staging.buffer);
+            glDeleteBuffers(1, &transfer.staging.buffer);
+        }
+        return true;
+    });
+    m_transfers.erase(done, m_transfers.end());
+}
+
+OpenGLTextureUploader::Staging OpenGLTextureUploader::acquireStaging(std::size_t size) {
+    auto& state = OpenGLStateCache::get();
+
+    // Smallest idle buffer that fits
+    auto best = m_idleStaging.end();
+    for (auto it = m_idleStaging.begin(); it != m_idleStaging.end(); ++it) {
+        if (it->capacity >= size && (best == m_idleStaging.end() || it->capacity < best->capacity))
+            best = it;
+    }
+
+    if (best != m_idleStaging.end()) {
+        Staging staging = *best;
+        m_idleStaging.erase(best);
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer);
+        return staging;
+    }
+
+    Staging staging;
+    staging.capacity = size;
+    glGenBuffers(1, &staging.buffer);
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.buffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+    return staging;
+}
+
+void OpenGLTextureUploader::stage(Job& job) {
+    auto& state = OpenGLStateCache::get();
+    const std::size_t size = job.pixels.size();
+
+    Transfer transfer;
+    transfer.texture = job.texture;
+    transfer.source = std::move(job.image);
+    transfer.width = job.width;
+    transfer.height = job.height;
+    transfer.channels = job.channels;
+    transfer.staging = acquireStaging(size);
+
+    // The buffer's previous transfer has completed, so nothing waits here
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dst) {
+        std::memcpy(dst, job.pixels.data(), size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        transfer.mipLevels = OpenGLTexture::upload(transfer.textureId, nullptr, job.width, job.height,
+                                                   job.channels, job.desc, true);
+    } else {
+        // Mapping failed: upload straight from client memory
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        transfer.mipLevels = OpenGLTexture::upload(transfer.textureId, job.pixels.data(), job.width, job.height,
+                                                   job.channels, job.desc);
+    }
+
+    // Client-memory uploads elsewhere expect no unpack buffer
+    state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (GLAD_GL_ARB_sync)
+        transfer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_transfers.push_back(transfer);
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -1,4 +1,5 @@
 #include "retronomicon/graphics/opengl_window.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
 #include <stdexcept>
 #include <iostream>
 
@@ -78,7 +79,7 @@ void OpenGLWindow::handleResize(int newWidth, int newHeight) {
     m_width  = newWidth;
     m_height = newHeight;
 
-    glViewport(0, 0, m_width, m_height);
+    OpenGLStateCache::get().viewport(0, 0, m_width, m_height);
 }
 
 void OpenGLWindow::swapBuffers() {
@@ -0,0 +1,170 @@
+#include "retronomicon/graphics/renderer/opengl_command_buffer.h"
+#include "retronomicon/graphics/opengl_color.h"
+#include "retronomicon/graphics/renderer/opengl_texture_region.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+using retronomicon::opengl::graphics::OpenGLColor;
+
+OpenGLCommandBuffer::OpenGLCommandBuffer(int width, int height)
+    : m_width(width), m_height(height) {}
+
+void OpenGLCommandBuffer::setDrawOrder(uint8_t layer, uint32_t depth) {
+    m_drawLayer = layer;
+    m_drawDepth = depth;
+}
+
+void OpenGLCommandBuffer::reset() {
+    m_queue.clear();
+    m_drawLayer = 0;
+    m_drawDepth = OpenGLRenderQueue::SequentialDepth;
+    m_blendMode = BlendMode::Alpha;
+    m_samplerId = 0;
+}
+
+void OpenGLCommandBuffer::render(std::shared_ptr<Texture> texture,
+                                 const Vec2& position,
+                                 const Vec2& scale,
+                                 float rotation,
+                                 float alpha) {
+    if (!texture) return;
+
+    Rect target{
+        position.x, position.y,
+        texture->getWidth() * scale.x,
+        texture->getHeight() * scale.y
+    };
+
+    Rect source{0, 0,
+        (float)texture->getWidth(),
+        (float)texture->getHeight()
+    };
+
+    renderQuad(texture, target, source, rotation, alpha, Color::White());
+}
+
+void OpenGLCommandBuffer::renderQuad(std::shared_ptr<Texture> texture,
+                                     const Rect& target,
+                                     const Rect& source,
+                                     float rotation,
+                                     float alpha,
+                                     const Color& color) {
+    if (!texture) return;
+
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region)) {
+        std::cerr << "[OpenGLCommandBuffer] texture is not an OpenGL texture" << std::endl;
+        return;
+    }
+
+    float texW = (float)texture->getWidth();
+    float texH = (float)texture->getHeight();
+
+    uint8_t rgba[4];
+    OpenGLColor::packRGBA8(color, alpha, rgba);
+
+    const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                         quadShaderSlot(region),
+                                         m_queue.getSourceSlot(texture.get(), m_samplerId));
+
+    SpriteVertex* out = m_queue.pushQuads(key, region.textureId, 1, m_samplerId, texture.get());
+    writeQuadVertices(out,
+                      target.getX(), target.getY(),
+                      target.getWidth(), target.getHeight(),
+                      target.getAnchor().getX(), target.getAnchor().getY(),
+                      rotation,
+                      source.getX() / texW,
+                      source.getY() / texH,
+                      (source.getX() + source.getWidth()) / texW,
+                      (source.getY() + source.getHeight()) / texH,
+                      rgba);
+    remapVertices(region, out, OpenGLSpriteBatch::VerticesPerQuad);
+}
+
+void OpenGLCommandBuffer::renderInstanced(std::shared_ptr<Texture> texture,
+                                          const SpriteInstance* instances,
+                                          std::size_t count) {
+    if (!texture || !instances || count == 0) return;
+
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region)) {
+        std::cerr << "[OpenGLCommandBuffer] texture is not an OpenGL texture" << std::endl;
+        return;
+    }
+
+    // The instanced shader samples 2D textures only: record array layers as quads
+    if (region.target == TextureTarget::Texture2DArray) {
+        const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                             quadShaderSlot(region),
+                                             m_queue.getSourceSlot(texture.get(), m_samplerId));
+        SpriteVertex* out = m_queue.pushQuads(key, region.textureId, count, m_samplerId, texture.get());
+        for (std::size_t i = 0; i < count; ++i)
+            writeInstanceQuad(out + i * OpenGLSpriteBatch::VerticesPerQuad, instances[i]);
+        remapVertices(region, out, count * OpenGLSpriteBatch::VerticesPerQuad);
+        return;
+    }
+
+    const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                         OpenGLRenderQueue::ShaderInstanced,
+                                         m_queue.getSourceSlot(texture.get(), m_samplerId));
+    remapInstances(region,
+                   m_queue.pushInstances(key, region.textureId, instances, count, m_samplerId, texture.get()),
+                   count);
+}
+
+void OpenGLCommandBuffer::renderSprites(std::shared_ptr<Texture> texture,
+                                        const SpriteArrays& sprites,
+                                        std::size_t count) {
+    if (!texture || count == 0) return;
+
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region)) {
+        std::cerr << "[OpenGLCommandBuffer] texture is not an OpenGL texture" << std::endl;
+        return;
+    }
+
+    const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                         quadShaderSlot(region),
+                                         m_queue.getSourceSlot(texture.get(), m_samplerId));
+
+    SpriteVertex* out = m_queue.pushQuads(key, region.textureId, count, m_samplerId, texture.get());
+    buildSpriteVertices(sprites, count, out);
+    remapVertices(region, out, count * OpenGLSpriteBatch::VerticesPerQuad);
+}
+
+void OpenGLCommandBuffer::drawText(std::shared_ptr<Texture> atlas,
+                                   const OpenGLFontAsset& font,
+                                   std::string_view text,
+                                   const Vec2& position,
+                                   const Color& color,
+                                   float scale) {
+    if (!atlas || text.empty()) return;
+
+    TextureRegion region;
+    if (!resolveTextureRegion(atlas.get(), region)) {
+        std::cerr << "[OpenGLCommandBuffer] texture is not an OpenGL texture" << std::endl;
+        return;
+    }
+    if (font.isDistanceField() && region.target == TextureTarget::Texture2D)
+        region.target = TextureTarget::DistanceField;
+
+    uint8_t rgba[4];
+    OpenGLColor::packRGBA8(color, 1.0f, rgba);
+
+    m_textScratch.clear();
+    const std::size_t count = layoutText(font, text, position.x, position.y, scale, rgba, m_textScratch);
+    if (count == 0) return;
+
+    const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                         quadShaderSlot(region),
+                                         m_queue.getSourceSlot(atlas.get(), m_samplerId));
+
+    SpriteVertex* out = m_queue.pushQuads(key, region.textureId, count, m_samplerId, atlas.get());
+    std::copy(m_textScratch.begin(), m_textScratch.end(), out);
+    remapVertices(region, out, count * OpenGLSpriteBatch::VerticesPerQuad);
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,219 @@
+#include "retronomicon/graphics/renderer/opengl_render_queue.h"
+#include "retronomicon/graphics/renderer/opengl_texture_region.h"
+
+#include <algorithm>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+// Below this size a comparison sort beats eight histogram passes
+static constexpr std::size_t kRadixThreshold = 256;
+
+static constexpr uint64_t kDepthMask = uint64_t(OpenGLRenderQueue::MaxDepth) << OpenGLRenderQueue::DepthShift;
+
+uint64_t OpenGLRenderQueue::makeKey(uint8_t layer,
+                                    uint32_t depth,
+                                    BlendMode blend,
+                                    uint32_t shader,
+                                    uint32_t textureSlot) {
+    const uint64_t d = std::min(depth, MaxDepth);
+
+    return (uint64_t(layer) << LayerShift)
+         | (d << DepthShift)
+         | (uint64_t(static_cast<uint8_t>(blend) & ((1u << BlendBits) - 1)) << BlendShift)
+         | (uint64_t(shader & ((1u << ShaderBits) - 1)) << ShaderShift)
+         | (uint64_t(textureSlot & ((1u << TextureBits) - 1)) << TextureShift);
+}
+
+OpenGLRenderQueue::DrawKey OpenGLRenderQueue::makeDrawKey(uint8_t layer,
+                                                          uint32_t depth,
+                                                          BlendMode blend,
+                                                          uint32_t shader,
+                                                          uint32_t textureSlot) {
+    if (depth != SequentialDepth)
+        return { makeKey(layer, depth, blend, shader, textureSlot), false };
+
+    // A new number only when the state changes, so runs can still merge
+    const uint64_t state = makeKey(layer, 0, blend, shader, textureSlot);
+    if (!m_sequenced || state != (m_sequenceKey & ~kDepthMask)) {
+        if (m_sequence < MaxDepth) ++m_sequence;
+        m_sequenceKey = state | (uint64_t(m_sequence) << DepthShift);
+        m_sequenced = true;
+    }
+    return { m_sequenceKey, true };
+}
+
+uint32_t OpenGLRenderQueue::getTextureSlot(unsigned int textureId, unsigned int samplerId) {
+    const uint64_t binding = (uint64_t(samplerId) << 32) | textureId;
+    if (binding == m_lastBinding && !m_textureSlots.empty())
+        return m_lastSlot;
+
+    auto [it, inserted] = m_textureSlots.try_emplace(binding,
+                                                     static_cast<uint32_t>(m_textureSlots.size()));
+    m_lastBinding = binding;
+    m_lastSlot = it->second;
+    return m_lastSlot;
+}
+
+uint32_t OpenGLRenderQueue::getSourceSlot(Texture* source, unsigned int samplerId) {
+    const std::pair<Texture*, unsigned int> binding{ source, samplerId };
+    if (binding == m_lastSource && !m_sourceSlots.empty())
+        return m_lastSourceSlot;
+
+    // Shares the numbering with getTextureSlot() so the two never collide
+    auto [it, inserted] = m_sourceSlots.try_emplace(binding,
+                                                    static_cast<uint32_t>(m_textureSlots.size() + m_sourceSlots.size()));
+    m_lastSource = binding;
+    m_lastSourceSlot = it->second;
+    return m_lastSourceSlot;
+}
+
+SpriteVertex* OpenGLRenderQueue::pushQuads(const DrawKey& key, unsigned int textureId, std::size_t count,
+                                           unsigned int samplerId, Texture* source) {
+    const std::size_t firstQuad = m_vertices.size() / OpenGLSpriteBatch::VerticesPerQuad;
+
+    // Extend the previous command when it is the same draw continued
+    if (!m_commands.empty()) {
+        Command& last = m_commands.back();
+        if (last.type == CommandType::Quads && last.key == key.key &&
+            last.sequential == key.sequential && last.source == source &&
+            last.textureId == textureId && last.samplerId == samplerId &&
+            last.first + last.count == firstQuad) {
+            last.count += static_cast<uint32_t>(count);
+            m_vertices.resize(m_vertices.size() + count * OpenGLSpriteBatch::VerticesPerQuad);
+            return m_vertices.data() + firstQuad * OpenGLSpriteBatch::VerticesPerQuad;
+        }
+    }
+
+    Command command;
+    command.key = key.key;
+    command.textureId = textureId;
+    command.samplerId = samplerId;
+    command.source = source;
+    command.first = static_cast<uint32_t>(firstQuad);
+    command.count = static_cast<uint32_t>(count);
+    command.type = CommandType::Quads;
+    command.sequential = key.sequential;
+    m_commands.push_back(command);
+
+    m_vertices.resize(m_vertices.size() + count * OpenGLSpriteBatch::VerticesPerQuad);
+    return m_vertices.data() + firstQuad * OpenGLSpriteBatch::VerticesPerQuad;
+}
+
+SpriteInstance* OpenGLRenderQueue::pushInstances(const DrawKey& key, unsigned int textureId,
+                                                 const SpriteInstance* instances, std::size_t count,
+                                                 unsigned int samplerId, Texture* source) {
+    if (!instances || count == 0) return nullptr;
+
+    Command command;
+    command.key = key.key;
+    command.textureId = textureId;
+    command.samplerId = samplerId;
+    command.source = source;
+    command.first = static_cast<uint32_t>(m_instances.size());
+    command.count = static_cast<uint32_t>(count);
+    command.type = CommandType::Instances;
+    command.sequential = key.sequential;
+    m_commands.push_back(command);
+
+    m_instances.insert(m_instances.end(), instances, instances + count);
+    return m_instances.data() + command.first;
+}
+
+void OpenGLRenderQueue::append(const OpenGLRenderQueue& other) {
+    if (other.m_commands.empty()) return;
+
+    const uint64_t slotMask = ((uint64_t(1) << TextureBits) - 1) << TextureShift;
+    const uint32_t quadBase = static_cast<uint32_t>(m_vertices.size() / OpenGLSpriteBatch::VerticesPerQuad);
+    const uint32_t instanceBase = static_cast<uint32_t>(m_instances.size());
+
+    m_commands.reserve(m_commands.size() + other.m_commands.size());
+    for (Command command : other.m_commands) {
+        // Recorded off the render thread: the texture may have been evicted since
+        if (command.source) {
+            TextureRegion region;
+            command.textureId = resolveTextureRegion(command.source, region, true) ? region.textureId : 0;
+            command.source = nullptr;
+        }
+
+        command.key = (command.key & ~slotMask)
+                    | (uint64_t(getTextureSlot(command.textureId, command.samplerId)) << TextureShift);
+        if (command.sequential) {
+            const uint64_t depth = std::min<uint64_t>(((command.key & kDepthMask) >> DepthShift) + m_sequence,
+                                                      MaxDepth);
+            command.key = (command.key & ~kDepthMask) | (depth << DepthShift);
+        }
+        command.first += (command.type == CommandType::Quads) ? quadBase : instanceBase;
+        m_commands.push_back(command);
+    }
+
+    m_vertices.insert(m_vertices.end(), other.m_vertices.begin(), other.m_vertices.end());
+    m_instances.insert(m_instances.end(), other.m_instances.begin(), other.m_instances.end());
+
+    // The next sequential draw follows everything appended
+    m_sequence = static_cast<uint32_t>(std::min<uint64_t>(uint64_t(m_sequence) + other.m_sequence, MaxDepth));
+    m_sequenced = false;
+}
+
+// ------------------------------------------------------------
+// Stable LSD radix sort over the 8 key bytes
+// ------------------------------------------------------------
+void OpenGLRenderQueue::sort() {
+    const std::size_t n = m_commands.size();
+    if (n < 2) return;
+
+    if (n < kRadixThreshold) {
+        std::stable_sort(m_commands.begin(), m_commands.end(),
+                         [](const Command& a, const Command& b) { return a.key < b.key; });
+        return;
+    }
+
+    // Bytes that never differ cannot change the order
+    const uint64_t firstKey = m_commands[0].key;
+    uint64_t varying = 0;
+    for (const Command& c : m_commands)
+        varying |= c.key ^ firstKey;
+
+    m_scratch.resize(n);
+    Command* src = m_commands.data();
+    Command* dst = m_scratch.data();
+
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) continue;
+
+        std::size_t offsets[256] = {};
+        for (std::size_t i = 0; i < n; ++i)
+            ++offsets[(src[i].key >> shift) & 0xFF];
+
+        std::size_t sum = 0;
+        for (std::size_t& o : offsets) {
+            std::size_t c = o;
+            o = sum;
+            sum += c;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    if (src != m_commands.data())
+        m_commands.swap(m_scratch);
+}
+
+void OpenGLRenderQueue::clear() {
+    m_commands.clear();
+    m_vertices.clear();
+    m_instances.clear();
+    m_textureSlots.clear();
+    m_sourceSlots.clear();
+    m_lastBinding = 0;
+    m_lastSlot = 0;
+    m_lastSource = { nullptr, 0 };
+    m_lastSourceSlot = 0;
+    m_sequence = 0;
+    m_sequenceKey = 0;
+    m_sequenced = false;
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -1,14 +1,131 @@
 #include "retronomicon/graphics/renderer/opengl_renderer.h"
-#include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <glad/gl.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace retronomicon::opengl::graphics::renderer {
 
+// ------------------------------------------------------------
+// Sprite fragment shader sampling one of `slots` textures
+// ------------------------------------------------------------
+// GLSL 3.30 only allows constant sampler array indices, so the slot is
+// resolved with a switch. Gradients are taken outside the branch to keep
+// mip selection well defined.
+static std::string buildSpriteFragmentSource(std::size_t slots) {
+    std::string src =
+        "#version 330 core\n"
+        "in vec2 TexCoord;\n"
+        "in vec4 Color;\n"
+        "flat in uint Slot;\n"
+        "out vec4 FragColor;\n"
+        "uniform sampler2D uTextures[" + std::to_string(slots) + "];\n"
+        "void main() {\n"
+        "    vec2 dx = dFdx(TexCoord);\n"
+        "    vec2 dy = dFdy(TexCoord);\n"
+        "    vec4 texel;\n"
+        "    switch (int(Slot)) {\n";
+
+    for (std::size_t i = 0; i < slots; ++i) {
+        const std::string n = std::to_string(i);
+        src += (i + 1 < slots ? "    case " + n + ": " : "    default: ")
+             + "texel = textureGrad(uTextures[" + n + "], TexCoord, dx, dy); break;\n";
+    }
+
+    src +=
+        "    }\n"
+        "    FragColor = texel * Color;\n"
+        "}\n";
+    return src;
+}
+
+// ------------------------------------------------------------
+// Shader sampling a GL_TEXTURE_2D_ARRAY by per-vertex layer
+// ------------------------------------------------------------
+static const char* kArrayVertexSrc = R"(
+    #version 330 core
+    layout (location = 0) in vec2 aPos;
+    layout (location = 1) in vec2 aTexCoord;
+    layout (location = 2) in vec4 aColor;
+    layout (location = 3) in uint aLayer;
+
+    uniform mat4 uProjection;
+
+    out vec2 TexCoord;
+    out vec4 Color;
+    flat out uint Layer;
+
+    void main() {
+        gl_Position = uProjection * vec4(aPos, 0.0, 1.0);
+        TexCoord = aTexCoord;
+        Color = aColor;
+        Layer = aLayer;
+    }
+)";
+
+static const char* kArrayFragmentSrc = R"(
+    #version 330 core
+    in vec2 TexCoord;
+    in vec4 Color;
+    flat in uint Layer;
+    out vec4 FragColor;
+
+    uniform sampler2DArray uTexture;
+
+    void main() {
+        FragColor = texture(uTexture, vec3(TexCoord, float(Layer))) * Color;
+    }
+)";
+
+// ------------------------------------------------------------
+// Shader drawing distance field text with outline and shadow
+// ------------------------------------------------------------
+// The atlas alpha is 0.5 on the glyph edge. fwidth() gives the change of
+// distance across one screen pixel, which keeps the edge antialiased over
+// about one pixel at any scale.
+static const char* kDistanceFieldFragmentSrc = R"(
+    #version 330 core
+    in vec2 TexCoord;
+    in vec4 Color;
+    out vec4 FragColor;
+
+    uniform sampler2D uTexture;
+    uniform vec4 uOutlineColor;
+    uniform float uOutlineWidth;
+    uniform vec4 uShadowColor;
+    uniform vec2 uShadowOffset;
+    uniform float uShadowSoftness;
+
+    void main() {
+        float d = texture(uTexture, TexCoord).a;
+        float w = max(fwidth(d), 1e-4);
+
+        float fill = smoothstep(0.5 - w, 0.5 + w, d);
+        float outlineEdge = 0.5 - 0.5 * uOutlineWidth;
+        float outline = smoothstep(outlineEdge - w, outlineEdge + w, d);
+
+        // Share of the covered area that is fill rather than outline;
+        // 1 everywhere without an outline, so the edge never tints
+        vec4 glyph = mix(uOutlineColor, Color, fill / max(outline, 1e-4));
+        glyph.a *= outline;
+
+        vec2 shadowUV = TexCoord - uShadowOffset / vec2(textureSize(uTexture, 0));
+        float s = texture(uTexture, shadowUV).a;
+        float soft = max(0.5 * uShadowSoftness, w);
+        vec4 shadow = vec4(uShadowColor.rgb, uShadowColor.a * Color.a * smoothstep(outlineEdge - soft, outlineEdge + soft, s));
+
+        float alpha = glyph.a + shadow.a * (1.0 - glyph.a);
+        vec3 rgb = alpha > 0.0 ? (glyph.rgb * glyph.a + shadow.rgb * shadow.a * (1.0 - glyph.a)) / alpha : vec3(0.0);
+        FragColor = vec4(rgb, alpha);
+    }
+)";
+
 OpenGLRenderer::OpenGLRenderer(GLFWwindow* window, int width, int height)
     : m_window(window), m_width(width), m_height(height) {}
 
@@ -22,76 +139,50 @@ void OpenGLRenderer::init() {
 
     glfwMakeContextCurrent(m_window);
 
+    // Nothing is known about a freshly current context
+    auto& state = OpenGLStateCache::get();
+    state.invalidate();
+
     // --- Viewport & Clear Color ---
-    glViewport(0, 0, m_width, m_height);
+    state.viewport(0, 0, m_width, m_height);
     glClearColor(0.1f, 0.1f, 0.3f, 1.0f);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    state.setBlend(true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_blendMode = BlendMode::Alpha;
+    m_appliedBlend = BlendMode::Alpha;
+
+    // --- Streaming geometry ---
+    m_stream.init();
+    m_batch.init(m_stream);
 
     // --- Compile shaders ---
     const char* vertexSrc = R"(
         #version 330 core
         layout (location = 0) in vec2 aPos;
         layout (location = 1) in vec2 aTexCoord;
+        layout (location = 2) in vec4 aColor;
+        layout (location = 4) in uint aSlot;
 
         uniform mat4 uProjection;
-        uniform mat4 uTransform;
-        uniform vec2 uTexOffset;
-        uniform vec2 uTexScale;
 
         out vec2 TexCoord;
+        out vec4 Color;
+        flat out uint Slot;
 
         void main() {
-            gl_Position = uProjection * uTransform * vec4(aPos, 0.0, 1.0);
-            TexCoord = uTexOffset + aTexCoord * uTexScale;
-        }
-    )";
-
-    const char* fragmentSrc = R"(
-        #version 330 core
-        in vec2 TexCoord;
-        out vec4 FragColor;
-
-        uniform sampler2D uTexture;
-        uniform float uAlpha;
-        uniform vec4 uColor;
-
-        void main() {
-            vec4 texColor = texture(uTexture, TexCoord);
-            FragColor = texColor * uColor;
-            FragColor.a *= uAlpha;
+            gl_Position = uProjection * vec4(aPos, 0.0, 1.0);
+            TexCoord = aTexCoord;
+            Color = aColor;
+            Slot = aSlot;
         }
     )";
 
-    m_shaderProgram = createShaderProgram(vertexSrc, fragmentSrc);
-
-    // --- Quad Geometry ---
-    float vertices[] = {
-        // pos      // tex
-        0.0f, 1.0f, 0.0f, 1.0f,
-        1.0f, 0.0f, 1.0f, 0.0f,
-        0.0f, 0.0f, 0.0f, 0.0f,
-
-        0.0f, 1.0f, 0.0f, 1.0f,
-        1.0f, 1.0f, 1.0f, 1.0f,
-        1.0f, 0.0f, 1.0f, 0.0f,
-    };
-
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-
-    glBindVertexArray(m_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
+    // One sampler per batch texture slot
+    const std::size_t slots = m_batch.getMaxSlots();
+    m_spriteShader.build(vertexSrc, buildSpriteFragmentSource(slots));
+    m_uProjection = m_spriteShader.findUniform("uProjection");
+    m_uTextures   = m_spriteShader.findUniform("uTextures");
 
     // --- Projection Uniform ---
     glm::mat4 projection = glm::ortho(
@@ -100,9 +191,31 @@ void OpenGLRenderer::init() {
         -1.0f, 1.0f
     );
 
-    glUseProgram(m_shaderProgram);
-    GLint projLoc = glGetUniformLocation(m_shaderProgram, "uProjection");
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, &projection[0][0]);
+    std::vector<int> units(slots);
+    for (std::size_t i = 0; i < slots; ++i)
+        units[i] = static_cast<int>(i);
+
+    m_spriteShader.use();
+    m_spriteShader.setMat4(m_uProjection, &projection[0][0]);
+    m_spriteShader.setIntArray(m_uTextures, units.data(), static_cast<int>(slots));
+
+    // --- Texture array path ---
+    m_arrayShader.build(kArrayVertexSrc, kArrayFragmentSrc);
+    m_arrayShader.use();
+    m_arrayShader.setMat4(m_arrayShader.findUniform("uProjection"), &projection[0][0]);
+    m_arrayShader.setInt(m_arrayShader.findUniform("uTexture"), 0);
+
+    // --- Distance field text ---
+    m_sdfShader.build(vertexSrc, kDistanceFieldFragmentSrc);
+    m_sdfShader.use();
+    m_sdfShader.setMat4(m_sdfShader.findUniform("uProjection"), &projection[0][0]);
+    m_sdfShader.setInt(m_sdfShader.findUniform("uTexture"), 0);
+    applyTextEffect();
+
+    // --- Instanced path ---
+    m_instancingSupported = OpenGLSpriteInstancer::isSupported();
+    if (m_instancingSupported)
+        m_instancer.init(&projection[0][0], m_stream);
 
     m_initialized = true;
 
@@ -117,6 +230,31 @@ void OpenGLRenderer::clear() {
 
 void OpenGLRenderer::show() {
     if (!m_window) return;
+
+    flush();
+
+    m_frameStats.drawCalls = m_batch.getDrawCalls() + m_instancer.getDrawCalls() + m_tilemapDrawCalls;
+    m_frameStats.quads     = m_batch.getDrawnQuads() + m_instancer.getDrawnInstances() + m_tilemapQuads;
+    m_frameStats.instances = m_instancer.getDrawnInstances();
+    m_frameStats.queuedCommands = m_queuedCommands;
+    m_frameStats.culled  = m_culledQuads;
+    m_frameStats.visible = m_visibleQuads;
+    m_queuedCommands = 0;
+    m_culledQuads = 0;
+    m_visibleQuads = 0;
+    m_tilemapDrawCalls = 0;
+    m_tilemapQuads = 0;
+    m_batch.resetCounters();
+    m_instancer.resetCounters();
+
+    auto& state = OpenGLStateCache::get();
+    state.nextFrame();
+    m_frameStats.stateChanges       = state.getFrameCounters().issued;
+    m_frameStats.stateChangesElided = state.getFrameCounters().elided;
+
+    // Everything streamed this frame becomes reusable once the GPU passes this point
+    m_stream.fence();
+
     glfwSwapBuffers(m_window);
     glfwPollEvents();
 }
@@ -126,13 +264,223 @@ bool OpenGLRenderer::shouldClose() const {
 }
 
 void OpenGLRenderer::shutdown() {
-    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
-    if (m_VBO) glDeleteBuffers(1, &m_VBO);
-    if (m_shaderProgram) glDeleteProgram(m_shaderProgram);
-
+    m_batch.shutdown();
+    m_instancer.shutdown();
+    m_stream.shutdown();
+    m_samplers.release();
+    m_sampler = 0;
+    m_spriteShader.release();
+    m_arrayShader.release();
+    m_sdfShader.release();
+    m_queue.clear();
+
+    m_batching = false;
     m_initialized = false;
 }
 
+void OpenGLRenderer::submit(OpenGLCommandBuffer& buffer) {
+    if (!m_initialized || buffer.empty()) return;
+
+    m_queue.append(buffer.getQueue());
+    buffer.reset();
+
+    if (!m_batching)
+        flush();
+}
+
+void OpenGLRenderer::setDrawOrder(uint8_t layer, uint32_t depth) {
+    m_drawLayer = layer;
+    m_drawDepth = depth;
+}
+
+void OpenGLRenderer::setBlendMode(BlendMode mode) {
+    m_blendMode = mode;
+}
+
+void OpenGLRenderer::setSampler(const SamplerDesc& desc) {
+    m_sampler = m_samplers.get(desc);
+}
+
+void OpenGLRenderer::setTextEffect(const TextEffect& effect) {
+    // Text already submitted keeps the previous effect
+    flush();
+    m_textEffect = effect;
+    if (m_initialized)
+        applyTextEffect();
+}
+
+void OpenGLRenderer::applyTextEffect() {
+    const TextEffect& e = m_textEffect;
+    const float outline[4] = { e.outlineColor.r(), e.outlineColor.g(), e.outlineColor.b(), e.outlineColor.a() };
+    const float shadow[4]  = { e.shadowColor.r(), e.shadowColor.g(), e.shadowColor.b(), e.shadowColor.a() };
+
+    m_sdfShader.use();
+    m_sdfShader.setVec4(m_sdfShader.findUniform("uOutlineColor"), outline);
+    m_sdfShader.setFloat(m_sdfShader.findUniform("uOutlineWidth"), std::clamp(e.outlineWidth, 0.0f, 1.0f));
+    m_sdfShader.setVec4(m_sdfShader.findUniform("uShadowColor"), shadow);
+    m_sdfShader.setVec2(m_sdfShader.findUniform("uShadowOffset"), e.shadowOffset.x, e.shadowOffset.y);
+    m_sdfShader.setFloat(m_sdfShader.findUniform("uShadowSoftness"), std::clamp(e.shadowSoftness, 0.0f, 1.0f));
+}
+
+void OpenGLRenderer::beginBatch() {
+    m_batching = true;
+}
+
+void OpenGLRenderer::endBatch() {
+    flush();
+    m_batching = false;
+}
+
+void OpenGLRenderer::flush() {
+    if (!m_initialized) return;
+
+    executeQueue();
+    flushBatch();
+}
+
+void OpenGLRenderer::flushBatch() {
+    if (m_batch.getPendingQuads() == 0) return;
+
+    switch (m_batch.getPendingTarget()) {
+        case TextureTarget::Texture2DArray: m_arrayShader.use();  break;
+        case TextureTarget::DistanceField:  m_sdfShader.use();    break;
+        default:                            m_spriteShader.use(); break;
+    }
+    m_batch.flush();
+}
+
+void OpenGLRenderer::applyBlendMode(BlendMode mode) {
+    if (mode == m_appliedBlend) return;
+
+    flushBatch();
+
+    auto& state = OpenGLStateCache::get();
+    switch (mode) {
+        case BlendMode::Alpha:
+            state.setBlend(true);
+            state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Additive:
+            state.setBlend(true);
+            state.blendFunc(GL_SRC_ALPHA, GL_ONE);
+            break;
+        case BlendMode::Multiply:
+            state.setBlend(true);
+            state.blendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Opaque:
+            state.setBlend(false);
+            break;
+    }
+
+    m_appliedBlend = mode;
+}
+
+SpriteVertex* OpenGLRenderer::reserveQuads(const TextureRegion& region,
+                                           std::size_t requested,
+                                           std::size_t& granted) {
+    if (m_batching) {
+        const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                             quadShaderSlot(region),
+                                             m_queue.getTextureSlot(region.textureId, m_sampler));
+        granted = requested;
+        return m_queue.pushQuads(key, region.textureId, requested, m_sampler);
+    }
+
+    applyBlendMode(m_blendMode);
+    return m_batch.allocateQuads(region.textureId, requested, granted, region.target, m_sampler);
+}
+
+// ------------------------------------------------------------
+// Viewport culling
+// ------------------------------------------------------------
+bool OpenGLRenderer::isVisible(const Bounds2D& bounds) {
+    if (bounds.intersects(getViewBounds())) {
+        ++m_visibleQuads;
+        return true;
+    }
+    ++m_culledQuads;
+    return false;
+}
+
+const SpriteInstance* OpenGLRenderer::cullInstances(const SpriteInstance* instances, std::size_t& count) {
+    const Bounds2D view = getViewBounds();
+
+    // Most calls are fully on screen: only copy from the first culled instance
+    std::size_t first = 0;
+    while (first < count) {
+        const SpriteInstance& in = instances[first];
+        if (!Bounds2D::fromQuad(in.x, in.y, in.width, in.height,
+                                in.anchorX, in.anchorY, in.rotation).intersects(view))
+            break;
+        ++first;
+    }
+
+    if (first == count) {
+        m_visibleQuads += count;
+        return instances;
+    }
+
+    m_instanceScratch.assign(instances, instances + first);
+    for (std::size_t i = first + 1; i < count; ++i) {
+        const SpriteInstance& in = instances[i];
+        if (Bounds2D::fromQuad(in.x, in.y, in.width, in.height,
+                               in.anchorX, in.anchorY, in.rotation).intersects(view))
+            m_instanceScratch.push_back(in);
+    }
+
+    m_visibleQuads += m_instanceScratch.size();
+    m_culledQuads  += count - m_instanceScratch.size();
+    count = m_instanceScratch.size();
+    return m_instanceScratch.data();
+}
+
+// ------------------------------------------------------------
+// Replays the sorted queue; the batch merges adjacent commands
+// ------------------------------------------------------------
+void OpenGLRenderer::executeQueue() {
+    if (m_queue.empty()) return;
+
+    m_queue.sort();
+
+    for (const auto& command : m_queue.getCommands()) {
+        applyBlendMode(OpenGLRenderQueue::getBlend(command.key));
+
+        if (command.type == OpenGLRenderQueue::CommandType::Instances) {
+            if (m_instancingSupported) {
+                flushBatch();
+                m_instancer.draw(command.textureId, m_queue.getInstances(command), command.count,
+                                 command.samplerId);
+                continue;
+            }
+
+            // Recorded by a command buffer that cannot know driver support: expand on the CPU
+            const SpriteInstance* instances = m_queue.getInstances(command);
+            for (std::size_t i = 0; i < command.count; ++i)
+                writeInstanceQuad(m_batch.allocateQuad(command.textureId, TextureTarget::Texture2D,
+                                                      command.samplerId),
+                                  instances[i]);
+            continue;
+        }
+
+        const TextureTarget target = quadTextureTarget(OpenGLRenderQueue::getShader(command.key));
+
+        const SpriteVertex* src = m_queue.getVertices(command);
+        std::size_t done = 0;
+        while (done < command.count) {
+            std::size_t granted = 0;
+            SpriteVertex* dst = m_batch.allocateQuads(command.textureId, command.count - done, granted,
+                                                        target, command.samplerId);
+            std::copy_n(src + done * OpenGLSpriteBatch::VerticesPerQuad,
+                        granted * OpenGLSpriteBatch::VerticesPerQuad, dst);
+            done += granted;
+        }
+    }
+
+    m_queuedCommands += m_queue.getCommands().size();
+    m_queue.clear();
+}
+
 void OpenGLRenderer::render(std::shared_ptr<Texture> texture,
                             const Vec2& position,
                             const Vec2& scale,
@@ -162,100 +510,255 @@ void OpenGLRenderer::renderQuad(std::shared_ptr<Texture> texture,
                                 const Color& color) {
     if (!m_initialized || !texture) return;
 
-    auto glTex = std::dynamic_pointer_cast<retronomicon::opengl::graphics::OpenGLTexture>(texture);
-    if (!glTex) {
-        std::cerr << "RenderQuad: texture is not an OpenGLTexture" << std::endl;
+    if (m_culling && !isVisible(Bounds2D::fromQuad(target.getX(), target.getY(),
+                                                   target.getWidth(), target.getHeight(),
+                                                   target.getAnchor().getX(), target.getAnchor().getY(),
+                                                   rotation)))
         return;
-    }
 
-    glUseProgram(m_shaderProgram);
+    // Raw pointer: avoids a shared_ptr copy per quad
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region, true)) {
+        std::cerr << "RenderQuad: texture is not an OpenGL texture" << std::endl;
+        return;
+    }
 
     float texW = (float)texture->getWidth();
     float texH = (float)texture->getHeight();
 
-    // --- Transform ---
-    glm::mat4 transform(1.0f);
+    // --- Texture UV from source rect ---
+    float u0 = source.getX() / texW;
+    float v0 = source.getY() / texH;
+    float u1 = (source.getX() + source.getWidth()) / texW;
+    float v1 = (source.getY() + source.getHeight()) / texH;
+
+    uint8_t rgba[4];
+    OpenGLColor::packRGBA8(color, alpha, rgba);
+
+    std::size_t granted = 0;
+    SpriteVertex* out = reserveQuads(region, 1, granted);
+    writeQuadVertices(out,
+                      target.getX(), target.getY(),
+                      target.getWidth(), target.getHeight(),
+                      target.getAnchor().getX(), target.getAnchor().getY(),
+                      rotation,
+                      u0, v0, u1, v1,
+                      rgba);
+
+    // Into the atlas page / array layer the texture lives in
+    remapVertices(region, out, OpenGLSpriteBatch::VerticesPerQuad);
+
+    if (!m_batching)
+        flush();
+}
 
-    float anchorModifierX = target.getWidth()*target.getAnchor().getX();
-    float anchorModifierY = target.getHeight()*target.getAnchor().getY();
-    float centerX = target.getX();
-    float centerY = target.getY();
-    transform = glm::translate(transform, glm::vec3(centerX,  centerY,0.0f));
-    transform = glm::rotate(transform, glm::radians(rotation), glm::vec3(0, 0, 1));
-    transform = glm::translate(transform, glm::vec3(-anchorModifierX,  -anchorModifierY,0.0f));
-    transform = glm::scale(transform, glm::vec3(target.getWidth(), target.getHeight() , 1.0f));
+void OpenGLRenderer::renderInstanced(std::shared_ptr<Texture> texture,
+                                     const SpriteInstance* instances,
+                                     std::size_t count) {
+    if (!m_initialized || !texture || !instances || count == 0) return;
 
-    // --- Texture UV from source rect ---
-    glm::vec2 texOffset(source.getX() / texW, source.getY() / texH);
-    glm::vec2 texScale(source.getWidth() / texW, source.getHeight() / texH);
-
-    GLint uTransformLoc = glGetUniformLocation(m_shaderProgram, "uTransform");
-    GLint uTexOffsetLoc = glGetUniformLocation(m_shaderProgram, "uTexOffset");
-    GLint uTexScaleLoc  = glGetUniformLocation(m_shaderProgram, "uTexScale");
-    GLint uAlphaLoc     = glGetUniformLocation(m_shaderProgram, "uAlpha");
-    GLint uColorLoc     = glGetUniformLocation(m_shaderProgram, "uColor");
-    GLint uTextureLoc   = glGetUniformLocation(m_shaderProgram, "uTexture");
-
-    glUniformMatrix4fv(uTransformLoc, 1, GL_FALSE, &transform[0][0]);
-    glUniform2fv(uTexOffsetLoc, 1, &texOffset[0]);
-    glUniform2fv(uTexScaleLoc, 1, &texScale[0]);
-    glUniform1f(uAlphaLoc, alpha);
-
-    // Try to downcast Color → OpenGLColor
-    if (auto glColorPtr = dynamic_cast<const OpenGLColor*>(&color)) {
-        glUniform4fv(uColorLoc, 1, glColorPtr->toNative());
-    } else {
-        // fallback for non-OpenGL color
-        OpenGLColor tempColor(color);
-        glUniform4fv(uColorLoc, 1, tempColor.toNative());
+    if (m_culling) {
+        instances = cullInstances(instances, count);
+        if (count == 0) return;
     }
 
-    glUniform1i(uTextureLoc, 0);
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region, true)) {
+        std::cerr << "RenderInstanced: texture is not an OpenGL texture" << std::endl;
+        return;
+    }
+
+    // The instanced shader samples 2D textures only
+    if (m_instancingSupported && region.target == TextureTarget::Texture2D) {
+        if (m_batching) {
+            const auto key = m_queue.makeDrawKey(m_drawLayer, m_drawDepth, m_blendMode,
+                                                 OpenGLRenderQueue::ShaderInstanced,
+                                                 m_queue.getTextureSlot(region.textureId, m_sampler));
+            remapInstances(region, m_queue.pushInstances(key, region.textureId, instances, count, m_sampler),
+                           count);
+            return;
+        }
 
-    glActiveTexture(GL_TEXTURE0);
-    glTex->bind();
+        if (!region.isFull()) {
+            // Culling may already have copied them
+            if (instances != m_instanceScratch.data())
+                m_instanceScratch.assign(instances, instances + count);
+            remapInstances(region, m_instanceScratch.data(), count);
+            instances = m_instanceScratch.data();
+        }
+
+        flushBatch();
+        applyBlendMode(m_blendMode);
+        m_instancer.draw(region.textureId, instances, count, m_sampler);
+        return;
+    }
 
-    glBindVertexArray(m_VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
-    glTex->unbind();
+    // Fallback: expand each instance into a batched quad
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t granted = 0;
+        SpriteVertex* out = reserveQuads(region, 1, granted);
+        writeInstanceQuad(out, instances[i]);
+        remapVertices(region, out, OpenGLSpriteBatch::VerticesPerQuad);
+    }
+
+    if (!m_batching)
+        flush();
 }
 
+void OpenGLRenderer::renderSprites(std::shared_ptr<Texture> texture,
+                                   const SpriteArrays& sprites,
+                                   std::size_t count) {
+    if (!m_initialized || !texture || count == 0) return;
 
-unsigned int OpenGLRenderer::compileShader(unsigned int type, const char* src) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &src, nullptr);
-    glCompileShader(shader);
+    TextureRegion region;
+    if (!resolveTextureRegion(texture.get(), region, true)) {
+        std::cerr << "RenderSprites: texture is not an OpenGL texture" << std::endl;
+        return;
+    }
 
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char log[512];
-        glGetShaderInfoLog(shader, 512, nullptr, log);
-        throw std::runtime_error(std::string("Shader compile error: ") + log);
+    std::size_t done = 0;
+    while (done < count) {
+        std::size_t granted = 0;
+        SpriteVertex* out = reserveQuads(region, count - done, granted);
+
+        // Offset every array so the kernel sees the next chunk from index 0
+        SpriteArrays chunk = sprites;
+        for (const float** arr : { &chunk.x, &chunk.y, &chunk.width, &chunk.height,
+                                   &chunk.anchorX, &chunk.anchorY, &chunk.rotation,
+                                   &chunk.u0, &chunk.v0, &chunk.u1, &chunk.v1 }) {
+            *arr += done;
+        }
+        if (chunk.color) chunk.color += done;
+
+        buildSpriteVertices(chunk, granted, out);
+        remapVertices(region, out, granted * OpenGLSpriteBatch::VerticesPerQuad);
+        done += granted;
     }
-    return shader;
+
+    if (!m_batching)
+        flush();
 }
 
-unsigned int OpenGLRenderer::createShaderProgram(const char* vertSrc, const char* fragSrc) {
-    GLuint vs = compileShader(GL_VERTEX_SHADER, vertSrc);
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragSrc);
-    GLuint prog = glCreateProgram();
-    glAttachShader(prog, vs);
-    glAttachShader(prog, fs);
-    glLinkProgram(prog);
-
-    GLint success;
-    glGetProgramiv(prog, GL_LINK_STATUS, &success);
-    if (!success) {
-        char log[512];
-        glGetProgramInfoLog(prog, 512, nullptr, log);
-        throw std::runtime_error(std::string("Shader link error: ") + log);
+void OpenGLRenderer::drawText(std::shared_ptr<Texture> atlas,
+                              const OpenGLFontAsset& font,
+                              std::string_view text,
+                              const Vec2& position,
+                              const Color& color,
+                              float scale) {
+    if (!m_initialized || !atlas || text.empty()) return;
+
+    TextureRegion region;
+    if (!resolveTextureRegion(atlas.get(), region, true)) {
+        std::cerr << "DrawText: atlas is not an OpenGL texture" << std::endl;
+        return;
+    }
+    if (font.isDistanceField() && region.target == TextureTarget::Texture2D)
+        region.target = TextureTarget::DistanceField;
+
+    uint8_t rgba[4];
+    OpenGLColor::packRGBA8(color, 1.0f, rgba);
+
+    m_textScratch.clear();
+    std::size_t count = layoutText(font, text, position.x, position.y, scale, rgba, m_textScratch);
+    if (m_culling)
+        count = cullGlyphs(count, nullptr);
+
+    submitGlyphs(region, m_textScratch.data(), count);
+
+    if (!m_batching)
+        flush();
+}
+
+void OpenGLRenderer::drawText(OpenGLGlyphCache& cache,
+                              std::string_view text,
+                              const Vec2& position,
+                              const Color& color,
+                              float scale) {
+    if (!m_initialized || text.empty()) return;
+
+    uint8_t rgba[4];
+    OpenGLColor::packRGBA8(color, 1.0f, rgba);
+
+    m_textScratch.clear();
+    m_textPages.clear();
+    std::size_t count = layoutText(cache, text, position.x, position.y, scale, rgba, m_textScratch, m_textPages);
+    if (m_culling)
+        count = cullGlyphs(count, m_textPages.data());
+
+    // One submission per run of glyphs sharing a cache page
+    std::size_t begin = 0;
+    while (begin < count) {
+        std::size_t end = begin + 1;
+        while (end < count && m_textPages[end] == m_textPages[begin])
+            ++end;
+
+        TextureRegion region;
+        if (resolveTextureRegion(cache.getPage(m_textPages[begin]).get(), region, true)) {
+            if (cache.getFont().isDistanceField())
+                region.target = TextureTarget::DistanceField;
+            submitGlyphs(region, &m_textScratch[begin * OpenGLSpriteBatch::VerticesPerQuad], end - begin);
+        }
+        begin = end;
+    }
+
+    if (!m_batching)
+        flush();
+}
+
+std::size_t OpenGLRenderer::cullGlyphs(std::size_t count, uint16_t* pages) {
+    // Glyphs are axis-aligned: corners 0 and 2 span the quad
+    std::size_t kept = 0;
+    for (std::size_t q = 0; q < count; ++q) {
+        const SpriteVertex* quad = &m_textScratch[q * OpenGLSpriteBatch::VerticesPerQuad];
+        if (!isVisible({ quad[0].x, quad[0].y, quad[2].x, quad[2].y })) continue;
+        if (kept != q) {
+            std::copy_n(quad, OpenGLSpriteBatch::VerticesPerQuad,
+                        &m_textScratch[kept * OpenGLSpriteBatch::VerticesPerQuad]);
+            if (pages) pages[kept] = pages[q];
+        }
+        ++kept;
+    }
+    return kept;
+}
+
+void OpenGLRenderer::submitGlyphs(const TextureRegion& region, const SpriteVertex* quads, std::size_t count) {
+    std::size_t done = 0;
+    while (done < count) {
+        std::size_t granted = 0;
+        SpriteVertex* out = reserveQuads(region, count - done, granted);
+        std::copy_n(&quads[done * OpenGLSpriteBatch::VerticesPerQuad],
+                    granted * OpenGLSpriteBatch::VerticesPerQuad, out);
+        remapVertices(region, out, granted * OpenGLSpriteBatch::VerticesPerQuad);
+        done += granted;
+    }
+}
+
+void OpenGLRenderer::renderTilemap(OpenGLTilemap& tilemap) {
+    if (!m_initialized) return;
+
+    TextureRegion region;
+    if (!tilemap.resolveTileset(region)) {
+        std::cerr << "RenderTilemap: tileset is not an OpenGL texture" << std::endl;
+        return;
+    }
+
+    // Keep submission order with everything recorded before
+    flush();
+    applyBlendMode(m_blendMode);
+
+    auto& state = OpenGLStateCache::get();
+    if (region.target == TextureTarget::Texture2DArray) {
+        m_arrayShader.use();
+        state.bindTexture(0, GL_TEXTURE_2D_ARRAY, region.textureId);
+    } else {
+        m_spriteShader.use();
+        state.bindTexture(0, GL_TEXTURE_2D, region.textureId);
     }
+    if (OpenGLSamplerCache::isSupported())
+        state.bindSampler(0, m_sampler);
 
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return prog;
+    m_tilemapQuads += tilemap.draw(getViewBounds(), region);
+    m_tilemapDrawCalls += tilemap.getDrawnChunks();
 }
 
 } // namespace retronomicon::opengl::graphics::renderer
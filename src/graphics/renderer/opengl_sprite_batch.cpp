@@ -0,0 +1,259 @@
+#include "retronomicon/graphics/renderer/opengl_sprite_batch.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+// 16-bit indices address at most 65536 vertices
+static constexpr std::size_t kMaxIndexableQuads = 65536 / OpenGLSpriteBatch::VerticesPerQuad;
+
+void writeQuadVertices(SpriteVertex* out,
+                       float x, float y,
+                       float width, float height,
+                       float anchorX, float anchorY,
+                       float rotation,
+                       float u0, float v0, float u1, float v1,
+                       const uint8_t rgba[4]) {
+    float originX = -width  * anchorX;
+    float originY = -height * anchorY;
+
+    float radians = rotation * 0.017453292519943295f;
+    float cosR = std::cos(radians);
+    float sinR = std::sin(radians);
+
+    // Corners in quad space: (0,0) (1,0) (1,1) (0,1)
+    static const float cornerX[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+    static const float cornerY[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+    for (int i = 0; i < 4; ++i) {
+        float lx = originX + cornerX[i] * width;
+        float ly = originY + cornerY[i] * height;
+
+        SpriteVertex& v = out[i];
+        v.x = x + lx * cosR - ly * sinR;
+        v.y = y + lx * sinR + ly * cosR;
+        v.u = cornerX[i] ? u1 : u0;
+        v.v = cornerY[i] ? v1 : v0;
+        v.r = rgba[0];
+        v.g = rgba[1];
+        v.b = rgba[2];
+        v.a = rgba[3];
+        v.layer = 0;
+        v.slot = 0;
+    }
+}
+
+OpenGLSpriteBatch::OpenGLSpriteBatch(std::size_t maxQuads)
+    : m_maxQuads(std::clamp<std::size_t>(maxQuads, 1, kMaxIndexableQuads)) {}
+
+OpenGLSpriteBatch::~OpenGLSpriteBatch() {
+    shutdown();
+}
+
+void OpenGLSpriteBatch::init(OpenGLStreamBuffer& stream) {
+    m_stream = &stream;
+    m_allocation = {};
+    m_quadCount = 0;
+    m_textureId = 0;
+    m_slotCount = 0;
+    m_stampedQuads = 0;
+    m_baseVertex = GLAD_GL_ARB_draw_elements_base_vertex != 0;
+    m_samplers = GLAD_GL_ARB_sampler_objects != 0;
+
+    GLint maxUnits = 1;
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+    m_maxSlots = std::clamp<std::size_t>(static_cast<std::size_t>(maxUnits), 1, MaxSlots);
+
+    // Never reserve more than the ring can hold
+    m_maxQuads = std::min(m_maxQuads,
+                          stream.getCapacity() / (VerticesPerQuad * sizeof(SpriteVertex)));
+
+    // --- Static index buffer: two triangles per quad ---
+    std::vector<GLushort> indices(m_maxQuads * IndicesPerQuad);
+    for (std::size_t q = 0; q < m_maxQuads; ++q) {
+        GLushort base = static_cast<GLushort>(q * VerticesPerQuad);
+        GLushort* idx = &indices[q * IndicesPerQuad];
+        idx[0] = base + 0;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base + 2;
+        idx[4] = base + 3;
+        idx[5] = base + 0;
+    }
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_EBO);
+
+    auto& state = OpenGLStateCache::get();
+    state.bindVertexArray(m_VAO);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 indices.size() * sizeof(GLushort),
+                 indices.data(),
+                 GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glEnableVertexAttribArray(3);
+    glEnableVertexAttribArray(4);
+    setVertexLayout(0);
+
+    state.bindVertexArray(0);
+}
+
+void OpenGLSpriteBatch::setVertexLayout(std::size_t offset) {
+    const GLsizei stride = sizeof(SpriteVertex);
+
+    OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_stream->getBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + offsetof(SpriteVertex, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + offsetof(SpriteVertex, u)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void*)(offset + offsetof(SpriteVertex, r)));
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_SHORT, stride,
+                           (void*)(offset + offsetof(SpriteVertex, layer)));
+    glVertexAttribIPointer(4, 1, GL_UNSIGNED_SHORT, stride,
+                           (void*)(offset + offsetof(SpriteVertex, slot)));
+}
+
+void OpenGLSpriteBatch::shutdown() {
+    auto& state = OpenGLStateCache::get();
+    if (m_VAO) {
+        state.forgetVertexArray(m_VAO);
+        glDeleteVertexArrays(1, &m_VAO);
+    }
+    if (m_EBO) glDeleteBuffers(1, &m_EBO);
+
+    m_VAO = 0;
+    m_EBO = 0;
+    m_stream = nullptr;
+    m_allocation = {};
+    m_quadCount = 0;
+    m_textureId = 0;
+    m_slotCount = 0;
+    m_stampedQuads = 0;
+}
+
+SpriteVertex* OpenGLSpriteBatch::allocateQuad(unsigned int textureId, TextureTarget target, unsigned int samplerId) {
+    std::size_t granted = 0;
+    return allocateQuads(textureId, 1, granted, target, samplerId);
+}
+
+int OpenGLSpriteBatch::acquireSlot(unsigned int textureId, unsigned int samplerId) {
+    // Consecutive quads usually share a texture
+    if (m_slotCount > 0 && m_slots[m_currentSlot] == textureId && m_slotSamplers[m_currentSlot] == samplerId)
+        return m_currentSlot;
+
+    for (std::size_t i = 0; i < m_slotCount; ++i) {
+        if (m_slots[i] == textureId && m_slotSamplers[i] == samplerId) return static_cast<int>(i);
+    }
+
+    if (m_slotCount == m_maxSlots) return -1;
+
+    m_slots[m_slotCount] = textureId;
+    m_slotSamplers[m_slotCount] = samplerId;
+    return static_cast<int>(m_slotCount++);
+}
+
+void OpenGLSpriteBatch::stampSlots() {
+    if (m_stampedQuads == m_quadCount) return;
+
+    auto* vertices = static_cast<SpriteVertex*>(m_allocation.data);
+    for (std::size_t i = m_stampedQuads * VerticesPerQuad; i < m_quadCount * VerticesPerQuad; ++i)
+        vertices[i].slot = m_currentSlot;
+    m_stampedQuads = m_quadCount;
+}
+
+SpriteVertex* OpenGLSpriteBatch::allocateQuads(unsigned int textureId,
+                                               std::size_t requested,
+                                               std::size_t& granted,
+                                               TextureTarget target,
+                                               unsigned int samplerId) {
+    if (!m_samplers) samplerId = 0;
+
+    // The previous caller has filled its vertices by now
+    stampSlots();
+
+    if (m_quadCount > 0 && (target != m_textureTarget || m_quadCount == m_maxQuads))
+        flush();
+
+    int slot = 0;
+    if (target == TextureTarget::Texture2D) {
+        slot = acquireSlot(textureId, samplerId);
+        if (slot < 0) {
+            flush();
+            slot = acquireSlot(textureId, samplerId);
+        }
+    } else {
+        if (m_quadCount > 0 && (textureId != m_textureId || samplerId != m_samplerId))
+            flush();
+        m_textureId = textureId;
+        m_samplerId = samplerId;
+    }
+
+    if (!m_allocation.data) {
+        m_allocation = m_stream->allocate(m_maxQuads * VerticesPerQuad * sizeof(SpriteVertex),
+                                          sizeof(SpriteVertex));
+    }
+
+    granted = std::min(requested, m_maxQuads - m_quadCount);
+
+    m_textureTarget = target;
+    m_currentSlot = static_cast<uint16_t>(slot);
+    auto* vertices = static_cast<SpriteVertex*>(m_allocation.data) + m_quadCount * VerticesPerQuad;
+    m_quadCount += granted;
+    return vertices;
+}
+
+void OpenGLSpriteBatch::flush() {
+    if (m_quadCount == 0 || !m_VAO) {
+        m_slotCount = 0;
+        return;
+    }
+
+    stampSlots();
+
+    const std::size_t vertexCount = m_quadCount * VerticesPerQuad;
+    m_stream->commit(m_allocation, vertexCount * sizeof(SpriteVertex));
+
+    auto& state = OpenGLStateCache::get();
+    if (m_textureTarget != TextureTarget::Texture2D) {
+        // Single texture on unit 0
+        state.bindTexture(0, m_textureTarget == TextureTarget::Texture2DArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D,
+                          m_textureId);
+        if (m_samplers) state.bindSampler(0, m_samplerId);
+    } else {
+        for (std::size_t i = 0; i < m_slotCount; ++i) {
+            state.bindTexture(static_cast<unsigned int>(i), GL_TEXTURE_2D, m_slots[i]);
+            if (m_samplers) state.bindSampler(static_cast<unsigned int>(i), m_slotSamplers[i]);
+        }
+        state.activeTexture(0);
+    }
+    state.bindVertexArray(m_VAO);
+
+    const GLsizei indexCount = static_cast<GLsizei>(m_quadCount * IndicesPerQuad);
+    if (m_baseVertex) {
+        glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, nullptr,
+                                 static_cast<GLint>(m_allocation.offset / sizeof(SpriteVertex)));
+    } else {
+        setVertexLayout(m_allocation.offset);
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, nullptr);
+    }
+
+    ++m_drawCalls;
+    m_drawnQuads += m_quadCount;
+    m_quadCount = 0;
+    m_stampedQuads = 0;
+    m_slotCount = 0;
+    m_currentSlot = 0;
+    m_allocation = {};
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
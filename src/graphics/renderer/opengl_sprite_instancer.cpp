@@ -0,0 +1,177 @@
+#include "retronomicon/graphics/renderer/opengl_sprite_instancer.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+static const char* kInstancedVertexSrc = R"(
+    #version 330 core
+    layout (location = 0) in vec2 aCorner;
+    layout (location = 1) in vec4 iPosSize;   // x, y, width, height
+    layout (location = 2) in vec3 iAnchorRot; // anchor x, anchor y, rotation (deg)
+    layout (location = 3) in vec4 iTexRect;   // uv offset xy, uv scale xy
+    layout (location = 4) in vec4 iColor;
+
+    uniform mat4 uProjection;
+
+    out vec2 TexCoord;
+    out vec4 Color;
+
+    void main() {
+        vec2 local = (aCorner - iAnchorRot.xy) * iPosSize.zw;
+        float r = radians(iAnchorRot.z);
+        float c = cos(r);
+        float s = sin(r);
+        vec2 world = iPosSize.xy + vec2(local.x * c - local.y * s,
+                                        local.x * s + local.y * c);
+
+        gl_Position = uProjection * vec4(world, 0.0, 1.0);
+        TexCoord = iTexRect.xy + aCorner * iTexRect.zw;
+        Color = iColor;
+    }
+)";
+
+static const char* kInstancedFragmentSrc = R"(
+    #version 330 core
+    in vec2 TexCoord;
+    in vec4 Color;
+    out vec4 FragColor;
+
+    uniform sampler2D uTexture;
+
+    void main() {
+        FragColor = texture(uTexture, TexCoord) * Color;
+    }
+)";
+
+void writeInstanceQuad(SpriteVertex* out, const SpriteInstance& inst) {
+    const uint8_t rgba[4] = { inst.r, inst.g, inst.b, inst.a };
+
+    writeQuadVertices(out,
+                      inst.x, inst.y,
+                      inst.width, inst.height,
+                      inst.anchorX, inst.anchorY,
+                      inst.rotation,
+                      inst.uvOffsetX, inst.uvOffsetY,
+                      inst.uvOffsetX + inst.uvScaleX,
+                      inst.uvOffsetY + inst.uvScaleY,
+                      rgba);
+}
+
+OpenGLSpriteInstancer::OpenGLSpriteInstancer(std::size_t maxInstances)
+    : m_maxInstances(std::max<std::size_t>(maxInstances, 1)) {}
+
+OpenGLSpriteInstancer::~OpenGLSpriteInstancer() {
+    shutdown();
+}
+
+bool OpenGLSpriteInstancer::isSupported() {
+    return GLAD_GL_ARB_draw_instanced && GLAD_GL_ARB_instanced_arrays;
+}
+
+void OpenGLSpriteInstancer::init(const float* projection, OpenGLStreamBuffer& stream) {
+    m_stream = &stream;
+    m_maxInstances = std::min(m_maxInstances, stream.getCapacity() / sizeof(SpriteInstance));
+
+    m_shader.build(kInstancedVertexSrc, kInstancedFragmentSrc);
+    m_shader.use();
+    m_shader.setMat4(m_shader.findUniform("uProjection"), projection);
+    m_shader.setInt(m_shader.findUniform("uTexture"), 0);
+
+    // Unit quad as a triangle strip: (0,0) (1,0) (0,1) (1,1)
+    const float corners[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f,
+    };
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_quadVBO);
+
+    auto& state = OpenGLStateCache::get();
+    state.bindVertexArray(m_VAO);
+
+    state.bindBuffer(GL_ARRAY_BUFFER, m_quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    setInstanceLayout(0);
+
+    for (GLuint attr = 1; attr <= 4; ++attr) {
+        glEnableVertexAttribArray(attr);
+        glVertexAttribDivisorARB(attr, 1);
+    }
+
+    state.bindVertexArray(0);
+}
+
+void OpenGLSpriteInstancer::setInstanceLayout(std::size_t offset) {
+    const GLsizei stride = sizeof(SpriteInstance);
+
+    OpenGLStateCache::get().bindBuffer(GL_ARRAY_BUFFER, m_stream->getBuffer());
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + offsetof(SpriteInstance, x)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + offsetof(SpriteInstance, anchorX)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride,
+                          (void*)(offset + offsetof(SpriteInstance, uvOffsetX)));
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void*)(offset + offsetof(SpriteInstance, r)));
+}
+
+void OpenGLSpriteInstancer::shutdown() {
+    auto& state = OpenGLStateCache::get();
+    if (m_VAO) {
+        state.forgetVertexArray(m_VAO);
+        glDeleteVertexArrays(1, &m_VAO);
+    }
+    if (m_quadVBO) {
+        state.forgetBuffer(m_quadVBO);
+        glDeleteBuffers(1, &m_quadVBO);
+    }
+
+    m_VAO = 0;
+    m_quadVBO = 0;
+    m_stream = nullptr;
+    m_shader.release();
+}
+
+void OpenGLSpriteInstancer::draw(unsigned int textureId,
+                                 const SpriteInstance* instances,
+                                 std::size_t count,
+                                 unsigned int samplerId) {
+    if (!m_VAO || !instances || count == 0) return;
+
+    m_shader.use();
+
+    auto& state = OpenGLStateCache::get();
+    state.bindTexture(0, GL_TEXTURE_2D, textureId);
+    if (GLAD_GL_ARB_sampler_objects) state.bindSampler(0, samplerId);
+    state.bindVertexArray(m_VAO);
+
+    for (std::size_t first = 0; first < count; first += m_maxInstances) {
+        std::size_t chunk = std::min(m_maxInstances, count - first);
+        std::size_t bytes = chunk * sizeof(SpriteInstance);
+
+        auto allocation = m_stream->allocate(bytes, sizeof(SpriteInstance));
+        if (!allocation.data) break;
+
+        std::memcpy(allocation.data, instances + first, bytes);
+        m_stream->commit(allocation, bytes);
+
+        // No base-instance in GL 3.3: re-point the instanced attributes instead
+        setInstanceLayout(allocation.offset);
+
+        glDrawArraysInstancedARB(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(chunk));
+
+        ++m_drawCalls;
+        m_drawnInstances += chunk;
+    }
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
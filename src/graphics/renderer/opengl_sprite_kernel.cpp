@@ -0,0 +1,262 @@
+#include "retronomicon/graphics/renderer/opengl_sprite_kernel.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RETRO_SPRITE_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RETRO_SPRITE_KERNEL_SSE2 1
+#endif
+
+namespace retronomicon::opengl::graphics::renderer {
+
+// ------------------------------------------------------------
+// sin/cos approximation shared by every path (Cephes sinf/cosf
+// polynomials, accurate to a few ULP for |x| < 8192 radians)
+// ------------------------------------------------------------
+static constexpr float kDegToRad   = 0.017453292519943295f;
+static constexpr float kTwoOverPi  = 0.63661977236758134f;
+static constexpr float kPiOver2Hi  = 1.5703125f;
+static constexpr float kPiOver2Mid = 4.837512969970703125e-4f;
+static constexpr float kPiOver2Lo  = 7.54978995489188216e-8f;
+
+static constexpr float kSin1 = -1.6666654611e-1f;
+static constexpr float kSin2 =  8.3321608736e-3f;
+static constexpr float kSin3 = -1.9515295891e-4f;
+static constexpr float kCos1 =  4.166664568298827e-2f;
+static constexpr float kCos2 = -1.388731625493765e-3f;
+static constexpr float kCos3 =  2.443315711809948e-5f;
+
+static inline void sinCosScalar(float x, float& s, float& c) {
+    int   j  = static_cast<int>(std::nearbyint(x * kTwoOverPi));
+    float jf = static_cast<float>(j);
+    float y  = ((x - jf * kPiOver2Hi) - jf * kPiOver2Mid) - jf * kPiOver2Lo;
+    float z  = y * y;
+
+    float sp = y + y * z * (kSin1 + z * (kSin2 + z * kSin3));
+    float cp = 1.0f - 0.5f * z + z * z * (kCos1 + z * (kCos2 + z * kCos3));
+
+    bool swap = (j & 1) != 0;
+    s = swap ? cp : sp;
+    c = swap ? sp : cp;
+    if (j & 2)       s = -s;
+    if ((j + 1) & 2) c = -c;
+}
+
+static inline void writeSprite(SpriteVertex* out,
+                               const float vx[4], const float vy[4],
+                               float u0, float v0, float u1, float v1,
+                               uint32_t color) {
+    // Corner order (0,0) (1,0) (1,1) (0,1), matching writeQuadVertices()
+    const float us[4] = { u0, u1, u1, u0 };
+    const float vs[4] = { v0, v0, v1, v1 };
+
+    for (int i = 0; i < 4; ++i) {
+        SpriteVertex& v = out[i];
+        v.x = vx[i];
+        v.y = vy[i];
+        v.u = us[i];
+        v.v = vs[i];
+        std::memcpy(&v.r, &color, sizeof(color));
+        v.layer = 0;
+        v.slot = 0;
+    }
+}
+
+static inline uint32_t colorAt(const SpriteArrays& s, std::size_t i) {
+    return s.color ? s.color[i] : 0xFFFFFFFFu;
+}
+
+// ------------------------------------------------------------
+// Scalar path
+// ------------------------------------------------------------
+static void buildRange(const SpriteArrays& s, std::size_t begin, std::size_t end, SpriteVertex* out) {
+    for (std::size_t i = begin; i < end; ++i) {
+        float sinR, cosR;
+        sinCosScalar(s.rotation[i] * kDegToRad, sinR, cosR);
+
+        float lx0 = -s.width[i]  * s.anchorX[i];
+        float ly0 = -s.height[i] * s.anchorY[i];
+        float lx1 = lx0 + s.width[i];
+        float ly1 = ly0 + s.height[i];
+
+        const float lx[4] = { lx0, lx1, lx1, lx0 };
+        const float ly[4] = { ly0, ly0, ly1, ly1 };
+
+        float vx[4], vy[4];
+        for (int k = 0; k < 4; ++k) {
+            vx[k] = s.x[i] + lx[k] * cosR - ly[k] * sinR;
+            vy[k] = s.y[i] + lx[k] * sinR + ly[k] * cosR;
+        }
+
+        writeSprite(out + i * 4, vx, vy, s.u0[i], s.v0[i], s.u1[i], s.v1[i], colorAt(s, i));
+    }
+}
+
+void buildSpriteVerticesScalar(const SpriteArrays& sprites, std::size_t count, SpriteVertex* out) {
+    buildRange(sprites, 0, count, out);
+}
+
+// ------------------------------------------------------------
+// SIMD paths: one wrapper per instruction set, shared block body
+// ------------------------------------------------------------
+#if defined(RETRO_SPRITE_KERNEL_AVX2)
+
+struct SimdOps {
+    static constexpr std::size_t Width = 8;
+    using F = __m256;
+    using I = __m256i;
+
+    static F load(const float* p)        { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v)     { _mm256_storeu_ps(p, v); }
+    static F set(float v)                { return _mm256_set1_ps(v); }
+    static F add(F a, F b)               { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b)               { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b)               { return _mm256_mul_ps(a, b); }
+    static F neg(F a)                    { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+    static I toInt(F a)                  { return _mm256_cvtps_epi32(a); }
+    static F toFloat(I a)                { return _mm256_cvtepi32_ps(a); }
+    static I addInt(I a, int b)          { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+    static F bitMask(I a, int bit)       {
+        I m = _mm256_and_si256(a, _mm256_set1_epi32(bit));
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(bit)));
+    }
+    static F select(F mask, F a, F b)    { return _mm256_blendv_ps(b, a, mask); }
+    static F signIf(F mask, F a)         {
+        return _mm256_xor_ps(a, _mm256_and_ps(mask, _mm256_set1_ps(-0.0f)));
+    }
+};
+
+#elif defined(RETRO_SPRITE_KERNEL_SSE2)
+
+struct SimdOps {
+    static constexpr std::size_t Width = 4;
+    using F = __m128;
+    using I = __m128i;
+
+    static F load(const float* p)        { return _mm_loadu_ps(p); }
+    static void store(float* p, F v)     { _mm_storeu_ps(p, v); }
+    static F set(float v)                { return _mm_set1_ps(v); }
+    static F add(F a, F b)               { return _mm_add_ps(a, b); }
+    static F sub(F a, F b)               { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b)               { return _mm_mul_ps(a, b); }
+    static F neg(F a)                    { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+    static I toInt(F a)                  { return _mm_cvtps_epi32(a); }
+    static F toFloat(I a)                { return _mm_cvtepi32_ps(a); }
+    static I addInt(I a, int b)          { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+    static F bitMask(I a, int bit)       {
+        I m = _mm_and_si128(a, _mm_set1_epi32(bit));
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(m, _mm_set1_epi32(bit)));
+    }
+    static F select(F mask, F a, F b)    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+    static F signIf(F mask, F a)         {
+        return _mm_xor_ps(a, _mm_and_ps(mask, _mm_set1_ps(-0.0f)));
+    }
+};
+
+#endif
+
+#if defined(RETRO_SPRITE_KERNEL_AVX2) || defined(RETRO_SPRITE_KERNEL_SSE2)
+
+template <typename Ops>
+static inline void sinCosSimd(typename Ops::F x, typename Ops::F& s, typename Ops::F& c) {
+    using F = typename Ops::F;
+
+    auto j  = Ops::toInt(Ops::mul(x, Ops::set(kTwoOverPi)));
+    F    jf = Ops::toFloat(j);
+    F    y  = Ops::sub(x, Ops::mul(jf, Ops::set(kPiOver2Hi)));
+    y = Ops::sub(y, Ops::mul(jf, Ops::set(kPiOver2Mid)));
+    y = Ops::sub(y, Ops::mul(jf, Ops::set(kPiOver2Lo)));
+    F z = Ops::mul(y, y);
+
+    F sp = Ops::add(Ops::set(kSin2), Ops::mul(z, Ops::set(kSin3)));
+    sp = Ops::add(Ops::set(kSin1), Ops::mul(z, sp));
+    sp = Ops::add(y, Ops::mul(Ops::mul(y, z), sp));
+
+    F cp = Ops::add(Ops::set(kCos2), Ops::mul(z, Ops::set(kCos3)));
+    cp = Ops::add(Ops::set(kCos1), Ops::mul(z, cp));
+    cp = Ops::mul(Ops::mul(z, z), cp);
+    cp = Ops::add(Ops::sub(Ops::set(1.0f), Ops::mul(Ops::set(0.5f), z)), cp);
+
+    F swap = Ops::bitMask(j, 1);
+    s = Ops::select(swap, cp, sp);
+    c = Ops::select(swap, sp, cp);
+    s = Ops::signIf(Ops::bitMask(j, 2), s);
+    c = Ops::signIf(Ops::bitMask(Ops::addInt(j, 1), 2), c);
+}
+
+template <typename Ops>
+static void buildBlocks(const SpriteArrays& s, std::size_t count, SpriteVertex* out) {
+    using F = typename Ops::F;
+    constexpr std::size_t W = Ops::Width;
+
+    alignas(32) float vx[4][W];
+    alignas(32) float vy[4][W];
+
+    std::size_t i = 0;
+    for (; i + W <= count; i += W) {
+        F sinR, cosR;
+        sinCosSimd<Ops>(Ops::mul(Ops::load(s.rotation + i), Ops::set(kDegToRad)), sinR, cosR);
+
+        F w   = Ops::load(s.width + i);
+        F h   = Ops::load(s.height + i);
+        F lx0 = Ops::neg(Ops::mul(w, Ops::load(s.anchorX + i)));
+        F ly0 = Ops::neg(Ops::mul(h, Ops::load(s.anchorY + i)));
+        F lx1 = Ops::add(lx0, w);
+        F ly1 = Ops::add(ly0, h);
+
+        F px = Ops::load(s.x + i);
+        F py = Ops::load(s.y + i);
+
+        // Eight products cover all four corners
+        F x0c = Ops::mul(lx0, cosR), x1c = Ops::mul(lx1, cosR);
+        F x0s = Ops::mul(lx0, sinR), x1s = Ops::mul(lx1, sinR);
+        F y0c = Ops::mul(ly0, cosR), y1c = Ops::mul(ly1, cosR);
+        F y0s = Ops::mul(ly0, sinR), y1s = Ops::mul(ly1, sinR);
+
+        Ops::store(vx[0], Ops::add(px, Ops::sub(x0c, y0s)));
+        Ops::store(vy[0], Ops::add(py, Ops::add(x0s, y0c)));
+        Ops::store(vx[1], Ops::add(px, Ops::sub(x1c, y0s)));
+        Ops::store(vy[1], Ops::add(py, Ops::add(x1s, y0c)));
+        Ops::store(vx[2], Ops::add(px, Ops::sub(x1c, y1s)));
+        Ops::store(vy[2], Ops::add(py, Ops::add(x1s, y1c)));
+        Ops::store(vx[3], Ops::add(px, Ops::sub(x0c, y1s)));
+        Ops::store(vy[3], Ops::add(py, Ops::add(x0s, y1c)));
+
+        for (std::size_t k = 0; k < W; ++k) {
+            const std::size_t n = i + k;
+            const float cx[4] = { vx[0][k], vx[1][k], vx[2][k], vx[3][k] };
+            const float cy[4] = { vy[0][k], vy[1][k], vy[2][k], vy[3][k] };
+            writeSprite(out + n * 4, cx, cy, s.u0[n], s.v0[n], s.u1[n], s.v1[n], colorAt(s, n));
+        }
+    }
+
+    buildRange(s, i, count, out);
+}
+
+#endif
+
+void buildSpriteVertices(const SpriteArrays& sprites, std::size_t count, SpriteVertex* out) {
+#if defined(RETRO_SPRITE_KERNEL_AVX2) || defined(RETRO_SPRITE_KERNEL_SSE2)
+    buildBlocks<SimdOps>(sprites, count, out);
+#else
+    buildRange(sprites, 0, count, out);
+#endif
+}
+
+const char* getSpriteKernelIsa() {
+#if defined(RETRO_SPRITE_KERNEL_AVX2)
+    return "AVX2";
+#elif defined(RETRO_SPRITE_KERNEL_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,206 @@
+#include "retronomicon/graphics/renderer/opengl_text_layout.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+static constexpr int kTabSpaces = 4;
+static constexpr uint32_t kReplacement = 0xFFFD;
+
+using GlyphMetrics = OpenGLFontAsset::GlyphMetrics;
+
+// Horizontal advance of a tab starting at a pen offset from the line start
+static float tabAdvance(const OpenGLFontAsset& font, float penOffset, float scale) {
+    const auto* space = font.getGlyph(' ');
+    const float stop = (space ? float(space->advanceX) : float(font.getLineHeight()) * 0.5f) * kTabSpaces * scale;
+    if (stop <= 0.0f) return 0.0f;
+    return (std::floor(penOffset / stop) + 1.0f) * stop - penOffset;
+}
+
+// ------------------------------------------------------------
+// Glyph sources: bytes from the font atlas, codepoints from a cache
+// ------------------------------------------------------------
+namespace {
+
+struct AtlasSource {
+    const OpenGLFontAsset& font;
+    std::string_view text;
+    std::size_t pos = 0;
+
+    bool next(uint32_t& c) {
+        if (pos >= text.size()) return false;
+        c = static_cast<unsigned char>(text[pos++]);
+        return true;
+    }
+
+    const GlyphMetrics* glyph(uint32_t c, uint16_t& page) {
+        page = 0;
+        return font.getGlyph(static_cast<char>(c));
+    }
+};
+
+struct CacheSource {
+    OpenGLGlyphCache& cache;
+    std::string_view text;
+    std::size_t pos = 0;
+
+    bool next(uint32_t& c) {
+        if (pos >= text.size()) return false;
+        c = decodeUtf8(text, pos);
+        return true;
+    }
+
+    const GlyphMetrics* glyph(uint32_t c, uint16_t& page) {
+        const auto* cached = cache.getGlyph(c);
+        if (!cached) return nullptr;
+        page = cached->page;
+        return &cached->metrics;
+    }
+};
+
+} // namespace
+
+template <typename Source>
+static std::size_t layoutGlyphs(const OpenGLFontAsset& font,
+                                Source source,
+                                float x, float y,
+                                float scale,
+                                const uint8_t rgba[4],
+                                std::vector<SpriteVertex>& out,
+                                std::vector<uint16_t>* pages) {
+    const float lineHeight = float(font.getLineHeight()) * scale;
+    float penX = x;
+    float baseline = y + float(font.getAscent()) * scale;
+    std::size_t quads = 0;
+
+    uint32_t c;
+    while (source.next(c)) {
+        if (c == '\n') {
+            penX = x;
+            baseline += lineHeight;
+            continue;
+        }
+        if (c == '\t') {
+            penX += tabAdvance(font, penX - x, scale);
+            continue;
+        }
+
+        uint16_t page = 0;
+        const auto* glyph = source.glyph(c, page);
+        if (!glyph) continue;
+
+        if (glyph->width > 0 && glyph->height > 0) {
+            out.resize(out.size() + OpenGLSpriteBatch::VerticesPerQuad);
+            writeQuadVertices(&out[out.size() - OpenGLSpriteBatch::VerticesPerQuad],
+                              penX + float(glyph->bearingX) * scale,
+                              baseline - float(glyph->bearingY) * scale,
+                              float(glyph->width) * scale,
+                              float(glyph->height) * scale,
+                              0.0f, 0.0f, 0.0f,
+                              glyph->u0, glyph->v0, glyph->u1, glyph->v1,
+                              rgba);
+            if (pages) pages->push_back(page);
+            ++quads;
+        }
+
+        penX += float(glyph->advanceX) * scale;
+    }
+
+    return quads;
+}
+
+template <typename Source>
+static TextExtent measureGlyphs(const OpenGLFontAsset& font, Source source, float scale) {
+    const float lineHeight = float(font.getLineHeight()) * scale;
+    float lineWidth = 0.0f;
+
+    TextExtent extent;
+    extent.height = float(font.getAscent() - font.getDescent()) * scale;
+
+    uint32_t c;
+    while (source.next(c)) {
+        if (c == '\n') {
+            extent.width = std::max(extent.width, lineWidth);
+            extent.height += lineHeight;
+            lineWidth = 0.0f;
+            continue;
+        }
+        if (c == '\t') {
+            lineWidth += tabAdvance(font, lineWidth, scale);
+            continue;
+        }
+
+        uint16_t page;
+        if (const auto* glyph = source.glyph(c, page))
+            lineWidth += float(glyph->advanceX) * scale;
+    }
+
+    extent.width = std::max(extent.width, lineWidth);
+    return extent;
+}
+
+std::size_t layoutText(const OpenGLFontAsset& font,
+                       std::string_view text,
+                       float x, float y,
+                       float scale,
+                       const uint8_t rgba[4],
+                       std::vector<SpriteVertex>& out) {
+    return layoutGlyphs(font, AtlasSource{ font, text }, x, y, scale, rgba, out, nullptr);
+}
+
+TextExtent measureText(const OpenGLFontAsset& font, std::string_view text, float scale) {
+    if (text.empty()) return {};
+    return measureGlyphs(font, AtlasSource{ font, text }, scale);
+}
+
+std::size_t layoutText(OpenGLGlyphCache& cache,
+                       std::string_view utf8,
+                       float x, float y,
+                       float scale,
+                       const uint8_t rgba[4],
+                       std::vector<SpriteVertex>& out,
+                       std::vector<uint16_t>& pages) {
+    return layoutGlyphs(cache.getFont(), CacheSource{ cache, utf8 }, x, y, scale, rgba, out, &pages);
+}
+
+TextExtent measureText(OpenGLGlyphCache& cache, std::string_view utf8, float scale) {
+    if (utf8.empty()) return {};
+    return measureGlyphs(cache.getFont(), CacheSource{ cache, utf8 }, scale);
+}
+
+// ------------------------------------------------------------
+// UTF-8
+// ------------------------------------------------------------
+uint32_t decodeUtf8(std::string_view text, std::size_t& pos) noexcept {
+    const auto byte = [&](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+
+    const unsigned char lead = byte(pos);
+    std::size_t length;
+    uint32_t c;
+    if (lead < 0x80)               { ++pos; return lead; }
+    else if ((lead & 0xE0) == 0xC0) { length = 2; c = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { length = 3; c = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { length = 4; c = lead & 0x07; }
+    else                            { ++pos; return kReplacement; }
+
+    if (pos + length > text.size()) { ++pos; return kReplacement; }
+
+    for (std::size_t i = 1; i < length; ++i) {
+        const unsigned char next = byte(pos + i);
+        if ((next & 0xC0) != 0x80) { ++pos; return kReplacement; }
+        c = (c << 6) | (next & 0x3F);
+    }
+
+    // Overlong forms, surrogates and values past U+10FFFF
+    static constexpr uint32_t kMinimum[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (c < kMinimum[length] || (c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF) {
+        ++pos;
+        return kReplacement;
+    }
+
+    pos += length;
+    return c;
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
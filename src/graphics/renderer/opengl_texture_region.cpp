@@ -0,0 +1,74 @@
+#include "retronomicon/graphics/renderer/opengl_texture_region.h"
+#include "retronomicon/graphics/opengl_sub_texture.h"
+#include "retronomicon/graphics/opengl_texture.h"
+#include "retronomicon/graphics/opengl_texture_array_pool.h"
+
+namespace retronomicon::opengl::graphics::renderer {
+
+using retronomicon::opengl::graphics::OpenGLArrayTexture;
+using retronomicon::opengl::graphics::OpenGLSubTexture;
+using retronomicon::opengl::graphics::OpenGLTexture;
+
+bool resolveTextureRegion(Texture* texture, TextureRegion& out, bool renderThread) {
+    // Texture names are only read where they are written: the render thread
+    if (auto glTex = dynamic_cast<OpenGLTexture*>(texture)) {
+        glTex->touch();
+        if (renderThread && glTex->isEvicted())
+            glTex->restore();
+
+        out = TextureRegion{};
+        out.textureId = renderThread ? glTex->getId() : 0;
+        return true;
+    }
+
+    if (auto sub = dynamic_cast<const OpenGLSubTexture*>(texture)) {
+        sub->getPage()->touch();
+        out = TextureRegion{};
+        out.textureId = renderThread ? sub->getPage()->getId() : 0;
+        out.u0 = sub->getU0();
+        out.v0 = sub->getV0();
+        out.u1 = sub->getU1();
+        out.v1 = sub->getV1();
+        return true;
+    }
+
+    if (auto layered = dynamic_cast<const OpenGLArrayTexture*>(texture)) {
+        out = TextureRegion{};
+        out.textureId = renderThread ? layered->getPool()->getId() : 0;
+        out.target = TextureTarget::Texture2DArray;
+        out.layer = static_cast<uint16_t>(layered->getLayer());
+        return true;
+    }
+
+    return false;
+}
+
+void remapVertices(const TextureRegion& region, SpriteVertex* vertices, std::size_t count) {
+    if (!region.isFull()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            vertices[i].u = region.mapU(vertices[i].u);
+            vertices[i].v = region.mapV(vertices[i].v);
+        }
+    }
+
+    if (region.layer != 0) {
+        for (std::size_t i = 0; i < count; ++i)
+            vertices[i].layer = region.layer;
+    }
+}
+
+void remapInstances(const TextureRegion& region, SpriteInstance* instances, std::size_t count) {
+    if (region.isFull()) return;
+
+    const float scaleU = region.u1 - region.u0;
+    const float scaleV = region.v1 - region.v0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        instances[i].uvOffsetX = region.mapU(instances[i].uvOffsetX);
+        instances[i].uvOffsetY = region.mapV(instances[i].uvOffsetY);
+        instances[i].uvScaleX *= scaleU;
+        instances[i].uvScaleY *= scaleV;
+    }
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
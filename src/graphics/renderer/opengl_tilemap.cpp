@@ -0,0 +1,260 @@
+#include "retronomicon/graphics/renderer/opengl_tilemap.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <vector>
+#include <glad/gl.h>
+
+namespace retronomicon::opengl::graphics::renderer {
+
+OpenGLTilemap::OpenGLTilemap(int width, int height, int tileWidth, int tileHeight, int chunkSize)
+    : m_width(std::max(width, 0))
+    , m_height(std::max(height, 0))
+    , m_tileWidth(std::max(tileWidth, 1))
+    , m_tileHeight(std::max(tileHeight, 1))
+    , m_chunkSize(std::clamp(chunkSize, 1, MaxChunkSize)) {
+    m_chunksX = (m_width + m_chunkSize - 1) / m_chunkSize;
+    m_chunksY = (m_height + m_chunkSize - 1) / m_chunkSize;
+    m_tiles.assign(static_cast<std::size_t>(m_width) * m_height, EmptyTile);
+    m_chunks.resize(static_cast<std::size_t>(m_chunksX) * m_chunksY);
+}
+
+OpenGLTilemap::~OpenGLTilemap() {
+    release();
+}
+
+void OpenGLTilemap::markAllDirty() {
+    for (auto& chunk : m_chunks)
+        chunk.dirty = true;
+}
+
+void OpenGLTilemap::setTileset(std::shared_ptr<Texture> tileset, int spacing, int margin) {
+    m_tileset = std::move(tileset);
+    m_spacing = std::max(spacing, 0);
+    m_margin = std::max(margin, 0);
+    markAllDirty();
+}
+
+void OpenGLTilemap::setTile(int x, int y, int tile) {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+
+    int& cell = m_tiles[static_cast<std::size_t>(y) * m_width + x];
+    if (cell == tile) return;
+
+    cell = tile;
+    m_chunks[static_cast<std::size_t>(y / m_chunkSize) * m_chunksX + x / m_chunkSize].dirty = true;
+}
+
+int OpenGLTilemap::getTile(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return EmptyTile;
+    return m_tiles[static_cast<std::size_t>(y) * m_width + x];
+}
+
+void OpenGLTilemap::fill(int tile) {
+    std::fill(m_tiles.begin(), m_tiles.end(), tile);
+    markAllDirty();
+}
+
+void OpenGLTilemap::setOrigin(float x, float y) {
+    if (x == m_originX && y == m_originY) return;
+
+    m_originX = x;
+    m_originY = y;
+    markAllDirty();
+}
+
+Bounds2D OpenGLTilemap::getBounds() const noexcept {
+    return { m_originX, m_originY,
+             m_originX + float(m_width) * m_tileWidth,
+             m_originY + float(m_height) * m_tileHeight };
+}
+
+bool OpenGLTilemap::resolveTileset(TextureRegion& out) {
+    if (!m_tileset || !resolveTextureRegion(m_tileset.get(), out, true))
+        return false;
+
+    // The texture object may change (eviction); baked UVs only depend on
+    // the rectangle and the tileset size, which grows once an async
+    // upload replaces its placeholder
+    const int width = m_tileset->getWidth();
+    const int height = m_tileset->getHeight();
+    if (out.target != m_bakedRegion.target || out.layer != m_bakedRegion.layer ||
+        out.u0 != m_bakedRegion.u0 || out.v0 != m_bakedRegion.v0 ||
+        out.u1 != m_bakedRegion.u1 || out.v1 != m_bakedRegion.v1 ||
+        width != m_bakedWidth || height != m_bakedHeight) {
+        markAllDirty();
+    }
+    m_bakedRegion = out;
+    m_bakedWidth = width;
+    m_bakedHeight = height;
+    return true;
+}
+
+// ------------------------------------------------------------
+// GPU geometry
+// ------------------------------------------------------------
+void OpenGLTilemap::createIndexBuffer() {
+    const std::size_t quads = static_cast<std::size_t>(m_chunkSize) * m_chunkSize;
+
+    std::vector<GLushort> indices(quads * OpenGLSpriteBatch::IndicesPerQuad);
+    for (std::size_t q = 0; q < quads; ++q) {
+        GLushort base = static_cast<GLushort>(q * OpenGLSpriteBatch::VerticesPerQuad);
+        GLushort* idx = &indices[q * OpenGLSpriteBatch::IndicesPerQuad];
+        idx[0] = base + 0;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base + 2;
+        idx[4] = base + 3;
+        idx[5] = base + 0;
+    }
+
+    // Captured by the VAO bound by the caller
+    glGenBuffers(1, &m_EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 indices.size() * sizeof(GLushort),
+                 indices.data(),
+                 GL_STATIC_DRAW);
+}
+
+void OpenGLTilemap::rebuild(std::size_t index, const TextureRegion& region) {
+    Chunk& chunk = m_chunks[index];
+    chunk.dirty = false;
+    ++m_rebuilds;
+
+    const int chunkX = static_cast<int>(index % m_chunksX);
+    const int chunkY = static_cast<int>(index / m_chunksX);
+    const int x0 = chunkX * m_chunkSize;
+    const int y0 = chunkY * m_chunkSize;
+    const int x1 = std::min(x0 + m_chunkSize, m_width);
+    const int y1 = std::min(y0 + m_chunkSize, m_height);
+
+    const float texW = float(m_tileset->getWidth());
+    const float texH = float(m_tileset->getHeight());
+    const int columns = std::max((m_tileset->getWidth() - 2 * m_margin + m_spacing) / (m_tileWidth + m_spacing), 1);
+    const int rows    = std::max((m_tileset->getHeight() - 2 * m_margin + m_spacing) / (m_tileHeight + m_spacing), 1);
+    static const uint8_t white[4] = { 255, 255, 255, 255 };
+
+    m_scratch.clear();
+    m_scratch.reserve(static_cast<std::size_t>(m_chunkSize) * m_chunkSize * OpenGLSpriteBatch::VerticesPerQuad);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const int tile = m_tiles[static_cast<std::size_t>(y) * m_width + x];
+            if (tile < 0 || tile >= columns * rows) continue;
+
+            const float px = float(m_margin + (tile % columns) * (m_tileWidth + m_spacing));
+            const float py = float(m_margin + (tile / columns) * (m_tileHeight + m_spacing));
+
+            m_scratch.resize(m_scratch.size() + OpenGLSpriteBatch::VerticesPerQuad);
+            writeQuadVertices(&m_scratch[m_scratch.size() - OpenGLSpriteBatch::VerticesPerQuad],
+                              m_originX + float(x) * m_tileWidth,
+                              m_originY + float(y) * m_tileHeight,
+                              float(m_tileWidth), float(m_tileHeight),
+                              0.0f, 0.0f, 0.0f,
+                              px / texW, py / texH,
+                              (px + m_tileWidth) / texW, (py + m_tileHeight) / texH,
+                              white);
+        }
+    }
+    remapVertices(region, m_scratch.data(), m_scratch.size());
+
+    chunk.quadCount = m_scratch.size() / OpenGLSpriteBatch::VerticesPerQuad;
+    if (chunk.quadCount == 0) return;
+
+    auto& state = OpenGLStateCache::get();
+    if (!chunk.vao) {
+        glGenVertexArrays(1, &chunk.vao);
+        glGenBuffers(1, &chunk.vbo);
+
+        state.bindVertexArray(chunk.vao);
+        if (m_EBO)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        else
+            createIndexBuffer();
+        state.bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+
+        const GLsizei stride = sizeof(SpriteVertex);
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+        glEnableVertexAttribArray(3);
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(SpriteVertex, x));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(SpriteVertex, u));
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(SpriteVertex, r));
+        glVertexAttribIPointer(3, 1, GL_UNSIGNED_SHORT, stride, (void*)offsetof(SpriteVertex, layer));
+        glVertexAttribIPointer(4, 1, GL_UNSIGNED_SHORT, stride, (void*)offsetof(SpriteVertex, slot));
+    }
+
+    // Reuse the storage when the chunk did not grow
+    const std::size_t bytes = m_scratch.size() * sizeof(SpriteVertex);
+    state.bindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    if (bytes > chunk.capacity) {
+        glBufferData(GL_ARRAY_BUFFER, bytes, m_scratch.data(), GL_STATIC_DRAW);
+        chunk.capacity = bytes;
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_scratch.data());
+    }
+}
+
+std::size_t OpenGLTilemap::draw(const Bounds2D& view, const TextureRegion& region) {
+    m_drawnChunks = 0;
+    if (!m_tileset) return 0;
+
+    const float chunkW = float(m_chunkSize) * m_tileWidth;
+    const float chunkH = float(m_chunkSize) * m_tileHeight;
+
+    // Only chunks in the view's range are considered at all
+    const Bounds2D map = getBounds();
+    if (!map.intersects(view)) return 0;
+
+    const int cx0 = std::max(int((view.minX - m_originX) / chunkW), 0);
+    const int cy0 = std::max(int((view.minY - m_originY) / chunkH), 0);
+    const int cx1 = std::min(int((view.maxX - m_originX) / chunkW), m_chunksX - 1);
+    const int cy1 = std::min(int((view.maxY - m_originY) / chunkH), m_chunksY - 1);
+
+    auto& state = OpenGLStateCache::get();
+    std::size_t quads = 0;
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const std::size_t index = static_cast<std::size_t>(cy) * m_chunksX + cx;
+            if (m_chunks[index].dirty)
+                rebuild(index, region);
+
+            const Chunk& chunk = m_chunks[index];
+            if (chunk.quadCount == 0) continue;
+
+            state.bindVertexArray(chunk.vao);
+            glDrawElements(GL_TRIANGLES,
+                           static_cast<GLsizei>(chunk.quadCount * OpenGLSpriteBatch::IndicesPerQuad),
+                           GL_UNSIGNED_SHORT, nullptr);
+            ++m_drawnChunks;
+            quads += chunk.quadCount;
+        }
+    }
+
+    return quads;
+}
+
+void OpenGLTilemap::release() {
+    auto& state = OpenGLStateCache::get();
+    for (auto& chunk : m_chunks) {
+        if (chunk.vao) {
+            state.forgetVertexArray(chunk.vao);
+            glDeleteVertexArrays(1, &chunk.vao);
+        }
+        if (chunk.vbo) {
+            state.forgetBuffer(chunk.vbo);
+            glDeleteBuffers(1, &chunk.vbo);
+        }
+        chunk = Chunk{};
+    }
+
+    if (m_EBO) {
+        glDeleteBuffers(1, &m_EBO);
+        m_EBO = 0;
+    }
+}
+
+} // namespace retronomicon::opengl::graphics::renderer
@@ -0,0 +1,109 @@
+#include "retronomicon/graphics/skyline_packer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace retronomicon::opengl::graphics {
+
+SkylinePacker::SkylinePacker(int width, int height) {
+    reset(width, height);
+}
+
+void SkylinePacker::reset(int width, int height) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_usedArea = 0;
+    m_skyline.clear();
+    if (m_width > 0)
+        m_skyline.push_back({ 0, 0, m_width });
+}
+
+float SkylinePacker::getOccupancy() const noexcept {
+    const double area = double(m_width) * double(m_height);
+    return area > 0.0 ? static_cast<float>(double(m_usedArea) / area) : 0.0f;
+}
+
+int SkylinePacker::fit(std::size_t index, int width, int height, long long& wasted) const {
+    const int x = m_skyline[index].x;
+    if (x + width > m_width) return -1;
+
+    // The rectangle rests on the highest segment it spans
+    int y = 0;
+    int remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i) {
+        if (i >= m_skyline.size()) return -1;
+        y = std::max(y, m_skyline[i].y);
+        remaining -= m_skyline[i].width;
+    }
+    if (y + height > m_height) return -1;
+
+    wasted = 0;
+    remaining = width;
+    for (std::size_t i = index; remaining > 0; ++i) {
+        int span = std::min(remaining, m_skyline[i].width);
+        wasted += static_cast<long long>(y - m_skyline[i].y) * span;
+        remaining -= span;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int width, int height, PackedRect& out) {
+    if (width <= 0 || height <= 0) return false;
+
+    std::size_t bestIndex = m_skyline.size();
+    int bestTop = std::numeric_limits<int>::max();
+    long long bestWaste = std::numeric_limits<long long>::max();
+    int bestY = 0;
+
+    for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+        long long wasted = 0;
+        int y = fit(i, width, height, wasted);
+        if (y < 0) continue;
+
+        int top = y + height;
+        if (top < bestTop || (top == bestTop && wasted < bestWaste)) {
+            bestIndex = i;
+            bestTop = top;
+            bestWaste = wasted;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == m_skyline.size()) return false;
+
+    out = { m_skyline[bestIndex].x, bestY, width, height };
+
+    // Raise the skyline over the new rectangle
+    Segment raised{ out.x, bestY + height, width };
+    m_skyline.insert(m_skyline.begin() + bestIndex, raised);
+
+    const int right = out.x + width;
+    for (std::size_t i = bestIndex + 1; i < m_skyline.size(); ) {
+        Segment& s = m_skyline[i];
+        if (s.x >= right) break;
+
+        int overlap = right - s.x;
+        if (overlap >= s.width) {
+            m_skyline.erase(m_skyline.begin() + i);
+            continue;
+        }
+        s.x += overlap;
+        s.width -= overlap;
+        break;
+    }
+
+    // Merge neighbours at the same height
+    for (std::size_t i = 0; i + 1 < m_skyline.size(); ) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    m_usedArea += static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    return true;
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -0,0 +1,177 @@
+#include "retronomicon/graphics/spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace retronomicon::opengl::graphics {
+
+// ------------------------------------------------------------
+// Bounds2D
+// ------------------------------------------------------------
+Bounds2D Bounds2D::fromQuad(float x, float y, float width, float height,
+                            float anchorX, float anchorY, float rotation) noexcept {
+    const float left   = -width  * anchorX;
+    const float top    = -height * anchorY;
+    const float right  = left + width;
+    const float bottom = top + height;
+
+    if (rotation == 0.0f)
+        return { x + std::min(left, right), y + std::min(top, bottom),
+                 x + std::max(left, right), y + std::max(top, bottom) };
+
+    const float radians = rotation * 0.017453292519943295f;
+    const float cosR = std::cos(radians);
+    const float sinR = std::sin(radians);
+
+    const float cornerX[4] = { left, right, right, left };
+    const float cornerY[4] = { top, top, bottom, bottom };
+
+    const float firstX = x + left * cosR - top * sinR;
+    const float firstY = y + left * sinR + top * cosR;
+    Bounds2D bounds{ firstX, firstY, firstX, firstY };
+    for (int i = 1; i < 4; ++i) {
+        const float px = x + cornerX[i] * cosR - cornerY[i] * sinR;
+        const float py = y + cornerX[i] * sinR + cornerY[i] * cosR;
+        bounds.minX = std::min(bounds.minX, px);
+        bounds.minY = std::min(bounds.minY, py);
+        bounds.maxX = std::max(bounds.maxX, px);
+        bounds.maxY = std::max(bounds.maxY, py);
+    }
+    return bounds;
+}
+
+// ------------------------------------------------------------
+// SpatialGrid
+// ------------------------------------------------------------
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 256.0f)
+    , m_invCellSize(1.0f / m_cellSize) {}
+
+SpatialGrid::CellRange SpatialGrid::getCells(const Bounds2D& bounds) const noexcept {
+    CellRange range;
+    range.x0 = static_cast<int>(std::floor(bounds.minX * m_invCellSize));
+    range.y0 = static_cast<int>(std::floor(bounds.minY * m_invCellSize));
+    range.x1 = static_cast<int>(std::floor(bounds.maxX * m_invCellSize));
+    range.y1 = static_cast<int>(std::floor(bounds.maxY * m_invCellSize));
+    return range;
+}
+
+void SpatialGrid::link(Handle handle) {
+    const CellRange& cells = m_items[handle].cells;
+    for (int cy = cells.y0; cy <= cells.y1; ++cy)
+        for (int cx = cells.x0; cx <= cells.x1; ++cx)
+            m_cells[cellKey(cx, cy)].push_back(handle);
+}
+
+void SpatialGrid::unlink(Handle handle) {
+    const CellRange& cells = m_items[handle].cells;
+    for (int cy = cells.y0; cy <= cells.y1; ++cy) {
+        for (int cx = cells.x0; cx <= cells.x1; ++cx) {
+            auto it = m_cells.find(cellKey(cx, cy));
+            if (it == m_cells.end()) continue;
+
+            auto& handles = it->second;
+            auto pos = std::find(handles.begin(), handles.end(), handle);
+            if (pos != handles.end()) {
+                *pos = handles.back();
+                handles.pop_back();
+            }
+            if (handles.empty())
+                m_cells.erase(it);
+        }
+    }
+}
+
+SpatialGrid::Handle SpatialGrid::insert(const Bounds2D& bounds, uint32_t value) {
+    if (!(bounds.minX <= bounds.maxX && bounds.minY <= bounds.maxY))
+        return InvalidHandle;
+
+    Handle handle;
+    if (!m_free.empty()) {
+        handle = m_free.back();
+        m_free.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_items.size());
+        m_items.emplace_back();
+    }
+
+    Item& item = m_items[handle];
+    item.bounds = bounds;
+    item.value = value;
+    item.cells = getCells(bounds);
+    item.stamp = m_queryStamp;
+    item.alive = true;
+    link(handle);
+    return handle;
+}
+
+void SpatialGrid::update(Handle handle, const Bounds2D& bounds) {
+    if (handle >= m_items.size() || !m_items[handle].alive) return;
+
+    Item& item = m_items[handle];
+    item.bounds = bounds;
+
+    // Most moves stay within the same cells
+    const CellRange cells = getCells(bounds);
+    if (cells == item.cells) return;
+
+    unlink(handle);
+    item.cells = cells;
+    link(handle);
+}
+
+void SpatialGrid::remove(Handle handle) {
+    if (handle >= m_items.size() || !m_items[handle].alive) return;
+
+    unlink(handle);
+    m_items[handle].alive = false;
+    m_free.push_back(handle);
+}
+
+std::size_t SpatialGrid::query(const Bounds2D& view, std::vector<uint32_t>& out) {
+    const std::size_t before = out.size();
+
+    if (++m_queryStamp == 0) {
+        // Stamp wrapped: make sure no item looks already visited
+        for (auto& item : m_items) item.stamp = 0;
+        m_queryStamp = 1;
+    }
+
+    auto visit = [&](const std::vector<Handle>& handles) {
+        for (Handle handle : handles) {
+            Item& item = m_items[handle];
+            if (item.stamp == m_queryStamp) continue;
+            item.stamp = m_queryStamp;
+            if (item.bounds.intersects(view))
+                out.push_back(item.value);
+        }
+    };
+
+    const CellRange range = getCells(view);
+    const double viewCells = (double(range.x1) - range.x0 + 1) * (double(range.y1) - range.y0 + 1);
+
+    if (viewCells > double(m_cells.size())) {
+        // Zoomed far out: fewer occupied cells than cells in view
+        for (const auto& cell : m_cells)
+            visit(cell.second);
+    } else {
+        for (int cy = range.y0; cy <= range.y1; ++cy) {
+            for (int cx = range.x0; cx <= range.x1; ++cx) {
+                auto it = m_cells.find(cellKey(cx, cy));
+                if (it != m_cells.end())
+                    visit(it->second);
+            }
+        }
+    }
+
+    return out.size() - before;
+}
+
+void SpatialGrid::clear() {
+    m_items.clear();
+    m_free.clear();
+    m_cells.clear();
+    m_queryStamp = 0;
+}
+
+} // namespace retronomicon::opengl::graphics
@@ -1,16 +1,425 @@
 #include "retronomicon/manager/opengl_texture_manager.h"
 #include "retronomicon/graphics/opengl_texture.h"
 #include "retronomicon/asset/opengl_font_asset.h"
+#include "retronomicon/graphics/opengl_state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
 
 namespace retronomicon::opengl::manager {
 
-using retronomicon::opengl::graphics::OpenGLTexture;
+using retronomicon::opengl::graphics::OpenGLStateCache;
+using retronomicon::opengl::graphics::CompressedFormat;
+
+// ------------------------------------------------------------
+// Content hashing (64-bit multiply-mix over 8-byte words)
+// ------------------------------------------------------------
+static inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t hashPixels(const uint8_t* data, std::size_t size, uint64_t seed) {
+    uint64_t h = mix64(seed ^ (size * 0x9e3779b97f4a7c15ULL));
+
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        h = (h ^ mix64(word)) * 0x9e3779b97f4a7c15ULL;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    h = (h ^ mix64(tail)) * 0x9e3779b97f4a7c15ULL;
+
+    // 0 means "no content key"
+    h = mix64(h);
+    return h != 0 ? h : 1;
+}
+
+// Builds the cache key of an image; kind keeps differently stored copies apart
+static std::string assetIdentity(const std::string& kind, const retronomicon::asset::Asset& asset) {
+    const std::string& id = !asset.getPath().empty() ? asset.getPath() : asset.getName();
+    return id.empty() ? std::string() : kind + id;
+}
+
+// Kind prefix of an image texture; the descriptor changes the GPU copy
+static std::string imageKind(const TextureDesc& desc) {
+    return "image/" + std::to_string(desc.getKey()) + ":";
+}
+
+static uint64_t imageContent(uint64_t kind, const ImageAsset& image) {
+    const auto& pixels = image.getPixels();
+    if (pixels.empty()) return 0;
+
+    const uint64_t shape = (static_cast<uint64_t>(image.getWidth()) << 32)
+                         ^ (static_cast<uint64_t>(image.getHeight()) << 8)
+                         ^ static_cast<uint64_t>(image.getChannels());
+    return hashPixels(pixels.data(), pixels.size(), mix64(kind) ^ shape);
+}
+
+enum : uint64_t { KindImage = 1, KindPooled = 2, KindFont = 3 };
 
 OpenGLTextureManager::OpenGLTextureManager() {}
 
 std::shared_ptr<Texture>
 OpenGLTextureManager::createTexture(std::shared_ptr<ImageAsset> imageAsset) {
-    return std::make_shared<OpenGLTexture>(imageAsset);
+    return createTexture(std::move(imageAsset), m_defaultDesc);
+}
+
+std::shared_ptr<Texture>
+OpenGLTextureManager::createTexture(std::shared_ptr<ImageAsset> imageAsset, const TextureDesc& desc) {
+    CacheKey key;
+    if (m_cacheEnabled && imageAsset) {
+        key.identity = assetIdentity(imageKind(desc), *imageAsset);
+        key.bytes = static_cast<std::size_t>(imageAsset->getWidth()) * imageAsset->getHeight() * 4;
+        if (auto cached = findCached(key)) return cached;
+
+        key.content = imageContent(KindImage ^ (static_cast<uint64_t>(desc.getKey()) << 8), *imageAsset);
+        key.width = imageAsset->getWidth();
+        key.height = imageAsset->getHeight();
+        key.channels = imageAsset->getChannels();
+        key.size = imageAsset->getPixels().size();
+        key.pixels = std::shared_ptr<const std::vector<uint8_t>>(imageAsset, &imageAsset->getPixels());
+        if (auto cached = findCached(key)) return cached;
+    }
+
+    // Atlas pages have one level, clamped edges and a fixed filter
+    const bool atlasCompatible = m_atlas
+                              && desc.mips == graphics::MipPolicy::None
+                              && desc.wrap == graphics::TextureWrap::ClampToEdge
+                              && desc.filter == m_atlas->getPageDesc().filter
+                              && (desc.format == graphics::TextureFormat::Auto
+                                  || desc.format == graphics::TextureFormat::RGBA8);
+
+    std::shared_ptr<Texture> result;
+    if (atlasCompatible && imageAsset) {
+        result = m_atlas->add(imageAsset->getPixels().data(),
+                              imageAsset->getWidth(),
+                              imageAsset->getHeight(),
+                              imageAsset->getChannels());
+    }
+
+    if (!result) {
+        auto texture = std::make_shared<OpenGLTexture>(imageAsset, desc);
+        track(texture);
+        result = texture;
+    }
+
+    if (m_cacheEnabled) storeCached(key, result);
+    return result;
+}
+
+// ------------------------------------------------------------
+// Atlas mode
+// ------------------------------------------------------------
+void OpenGLTextureManager::enableAtlas(int pageSize, int padding, TextureFilter filter) {
+    m_atlas = std::make_unique<OpenGLTextureAtlas>(pageSize, padding, filter);
+}
+
+void OpenGLTextureManager::disableAtlas() {
+    m_atlas.reset();
+}
+
+// ------------------------------------------------------------
+// Texture array pools
+// ------------------------------------------------------------
+std::shared_ptr<Texture>
+OpenGLTextureManager::createPooledTexture(std::shared_ptr<ImageAsset> imageAsset) {
+    if (!imageAsset) return nullptr;
+
+    const int width    = imageAsset->getWidth();
+    const int height   = imageAsset->getHeight();
+    const int channels = imageAsset->getChannels();
+
+    CacheKey cacheKey;
+    if (m_cacheEnabled) {
+        cacheKey.identity = assetIdentity("pooled:", *imageAsset);
+        cacheKey.bytes = static_cast<std::size_t>(width) * height * 4;
+        if (auto cached = findCached(cacheKey)) return cached;
+
+        cacheKey.content = imageContent(KindPooled, *imageAsset);
+        cacheKey.width = width;
+        cacheKey.height = height;
+        cacheKey.channels = channels;
+        cacheKey.size = imageAsset->getPixels().size();
+        cacheKey.pixels = std::shared_ptr<const std::vector<uint8_t>>(imageAsset, &imageAsset->getPixels());
+        if (auto cached = findCached(cacheKey)) return cached;
+    }
+
+    if (channels == 3 || channels == 4) {
+        const uint64_t key = (static_cast<uint64_t>(width) << 36)
+                           | (static_cast<uint64_t>(height) << 8)
+                           | static_cast<uint64_t>(channels);
+
+        auto& pool = m_pools[key];
+        if (!pool)
+            pool = std::make_shared<OpenGLTextureArrayPool>(width, height, channels);
+
+        if (auto layer = pool->add(imageAsset->getPixels().data())) {
+            if (m_cacheEnabled) storeCached(cacheKey, layer);
+            return layer;
+        }
+    }
+
+    auto texture = std::make_shared<OpenGLTexture>(imageAsset);
+    track(texture);
+    if (m_cacheEnabled) storeCached(cacheKey, texture);
+    return texture;
+}
+
+// ------------------------------------------------------------
+// Asynchronous uploads
+// ------------------------------------------------------------
+std::shared_ptr<Texture>
+OpenGLTextureManager::createTextureAsync(std::shared_ptr<ImageAsset> imageAsset) {
+    return createTextureAsync(std::move(imageAsset), m_defaultDesc);
+}
+
+std::shared_ptr<Texture>
+OpenGLTextureManager::createTextureAsync(std::shared_ptr<ImageAsset> imageAsset, const TextureDesc& desc) {
+    if (!imageAsset) return nullptr;
+
+    // Only identity is checked: the pixels may not be decoded yet
+    CacheKey key;
+    if (m_cacheEnabled) {
+        key.identity = assetIdentity(imageKind(desc), *imageAsset);
+        key.bytes = static_cast<std::size_t>(imageAsset->getWidth()) * imageAsset->getHeight() * 4;
+        if (auto cached = findCached(key)) return cached;
+    }
+
+    if (!m_uploader)
+        m_uploader = std::make_unique<OpenGLTextureUploader>();
+    auto texture = m_uploader->enqueue(std::move(imageAsset), desc);
+    track(texture);
+    if (m_cacheEnabled) storeCached(key, texture);
+    return texture;
+}
+
+void OpenGLTextureManager::processUploads(std::size_t byteBudget) {
+    if (m_uploader)
+        m_uploader->update(byteBudget);
+}
+
+// ------------------------------------------------------------
+// Pre-compressed textures
+// ------------------------------------------------------------
+
+// Variants tried by createCompressedTexture, best quality first
+static const CompressedFormat kCompressedPreference[] = {
+    CompressedFormat::BC7,
+    CompressedFormat::BC3,
+    CompressedFormat::BC1,
+    CompressedFormat::ETC2_RGBA,
+    CompressedFormat::ETC2_RGB,
+};
+
+static bool fileExists(const std::string& path) {
+    return std::ifstream(path, std::ios::binary).good();
+}
+
+std::shared_ptr<Texture>
+OpenGLTextureManager::createCompressedTexture(const std::string& basePath, const TextureDesc& desc) {
+    CacheKey key;
+    if (m_cacheEnabled) {
+        key.identity = "ktx2/" + std::to_string(desc.getKey()) + ":" + basePath;
+        if (auto cached = findCached(key)) return cached;
+    }
+
+    // Natively supported variants first, then CPU-decoded ones, then the plain file
+    std::vector<std::string> candidates;
+    for (int native = 1; native >= 0; --native) {
+        for (CompressedFormat format : kCompressedPreference) {
+            if (OpenGLTexture::isFormatSupported(format) == (native != 0))
+                candidates.push_back(basePath + "." + graphics::getFormatName(format) + ".ktx2");
+        }
+    }
+    candidates.push_back(basePath + ".ktx2");
+
+    for (const auto& path : candidates) {
+        if (!fileExists(path)) continue;
+
+        try {
+            auto texture = std::make_shared<OpenGLTexture>(graphics::loadKtx2(path), desc);
+            if (texture->getFormat() == CompressedFormat::RGBA8 && path != candidates.back())
+                std::cerr << "[OpenGLTextureManager] " << path << " decoded on the CPU (format not supported)\n";
+
+            track(texture);
+            if (m_cacheEnabled) storeCached(key, texture);
+            return texture;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "[OpenGLTextureManager] Failed to load " << path << ": " << e.what() << "\n";
+        }
+    }
+
+    std::cerr << "[OpenGLTextureManager] No KTX2 texture found for " << basePath << "\n";
+    return nullptr;
+}
+
+// ------------------------------------------------------------
+// Residency budget
+// ------------------------------------------------------------
+void OpenGLTextureManager::track(const std::shared_ptr<OpenGLTexture>& texture) {
+    m_tracked.push_back(texture);
+}
+
+void OpenGLTextureManager::updateResidency() {
+    std::vector<std::shared_ptr<OpenGLTexture>> live;
+    live.reserve(m_tracked.size());
+
+    // Drop released textures; restore those used while evicted
+    std::size_t resident = 0;
+    auto out = m_tracked.begin();
+    for (auto& weak : m_tracked) {
+        auto texture = weak.lock();
+        if (!texture) continue;
+
+        if (texture->isEvicted() && texture->isRestoreRequested())
+            texture->restore();
+
+        resident += texture->getByteSize();
+        live.push_back(std::move(texture));
+        if (&*out != &weak) *out = std::move(weak);
+        ++out;
+    }
+    m_tracked.erase(out, m_tracked.end());
+
+    if (m_budget == 0 || resident <= m_budget) return;
+
+    // Oldest first; keep anything drawn in the current or previous frame
+    const uint64_t frame = OpenGLStateCache::get().getFrameIndex();
+    std::vector<OpenGLTexture*> cold;
+    for (auto& texture : live) {
+        if (texture->isEvictable() && texture->isResident() && texture->getLastUsedFrame() + 1 < frame)
+            cold.push_back(texture.get());
+    }
+    std::sort(cold.begin(), cold.end(), [](const OpenGLTexture* a, const OpenGLTexture* b) {
+        return a->getLastUsedFrame() < b->getLastUsedFrame();
+    });
+
+    for (OpenGLTexture* texture : cold) {
+        if (resident <= m_budget) break;
+
+        const std::size_t bytes = texture->getByteSize();
+        if (texture->evict()) {
+            resident -= bytes;
+            ++m_evictions;
+        }
+    }
+}
+
+TextureMemoryStats OpenGLTextureManager::getMemoryStats() const {
+    TextureMemoryStats stats;
+    stats.budgetBytes = m_budget;
+    stats.evictions = m_evictions;
+
+    for (const auto& weak : m_tracked) {
+        auto texture = weak.lock();
+        if (!texture) continue;
+
+        if (texture->isResident()) {
+            stats.residentBytes += texture->getByteSize();
+            ++stats.residentTextures;
+        } else if (texture->isEvicted()) {
+            ++stats.evictedTextures;
+        }
+        stats.restores += texture->getRestoreCount();
+    }
+    return stats;
+}
+
+// ------------------------------------------------------------
+// Deduplicating cache
+// ------------------------------------------------------------
+// Whether the pixels a texture was created from are still around and equal the requested ones
+static bool samePixels(const std::weak_ptr<const std::vector<uint8_t>>& cached,
+                       const std::shared_ptr<const std::vector<uint8_t>>& requested) {
+    auto pixels = cached.lock();
+    return pixels && requested && (pixels == requested || *pixels == *requested);
+}
+
+// A cached texture still holding the pixels it was created with
+static std::shared_ptr<Texture> lockUnmodified(const std::weak_ptr<Texture>& entry) {
+    auto texture = entry.lock();
+    auto gl = std::dynamic_pointer_cast<OpenGLTexture>(texture);
+    return gl && gl->isModified() ? nullptr : texture;
+}
+
+std::shared_ptr<Texture> OpenGLTextureManager::findCached(const CacheKey& key) {
+    std::shared_ptr<Texture> found;
+    bool byContent = false;
+
+    if (!key.identity.empty()) {
+        auto it = m_cacheByIdentity.find(key.identity);
+        if (it != m_cacheByIdentity.end()) {
+            found = lockUnmodified(it->second);
+            if (!found) m_cacheByIdentity.erase(it);
+        }
+    }
+
+    if (!found && key.content != 0) {
+        auto it = m_cacheByContent.find(key.content);
+        // Equal hashes of different pixels are a collision, not a match
+        if (it != m_cacheByContent.end()
+            && it->second.width == key.width && it->second.height == key.height
+            && it->second.channels == key.channels && it->second.size == key.size
+            && samePixels(it->second.pixels, key.pixels)) {
+            found = lockUnmodified(it->second.texture);
+            if (!found) {
+                m_cacheByContent.erase(it);
+            } else {
+                byContent = true;
+                if (!key.identity.empty()) m_cacheByIdentity[key.identity] = found;
+            }
+        }
+    }
+
+    if (found) {
+        ++m_cacheStats.hits;
+        if (byContent) ++m_cacheStats.contentHits;
+        m_cacheStats.bytesSaved += key.bytes;
+    }
+    return found;
+}
+
+void OpenGLTextureManager::storeCached(const CacheKey& key, const std::shared_ptr<Texture>& texture) {
+    if (!texture) return;
+
+    ++m_cacheStats.misses;
+    if (!key.identity.empty()) m_cacheByIdentity[key.identity] = texture;
+    if (key.content != 0)
+        m_cacheByContent[key.content] = { texture, key.width, key.height, key.channels, key.size, key.pixels };
+
+    if (m_cacheByIdentity.size() + m_cacheByContent.size() >= m_sweepAt) {
+        sweepCache();
+        m_sweepAt = std::max<std::size_t>(64, 2 * (m_cacheByIdentity.size() + m_cacheByContent.size()));
+    }
+}
+
+void OpenGLTextureManager::sweepCache() {
+    for (auto it = m_cacheByIdentity.begin(); it != m_cacheByIdentity.end();)
+        it = it->second.expired() ? m_cacheByIdentity.erase(it) : std::next(it);
+    for (auto it = m_cacheByContent.begin(); it != m_cacheByContent.end();)
+        it = it->second.texture.expired() ? m_cacheByContent.erase(it) : std::next(it);
+}
+
+TextureCacheStats OpenGLTextureManager::getCacheStats() const {
+    TextureCacheStats stats = m_cacheStats;
+    stats.entries = m_cacheByIdentity.size() + m_cacheByContent.size();
+    return stats;
+}
+
+void OpenGLTextureManager::clearCache() {
+    m_cacheByIdentity.clear();
+    m_cacheByContent.clear();
+    m_sweepAt = 64;
 }
 
 // ------------------------------------------------------------
@@ -35,13 +444,39 @@ OpenGLTextureManager::createTexture(std::shared_ptr<FontAsset> fontAsset)
         return nullptr;
     }
 
-    // Uses the raw-buffer constructor we added earlier
-    return std::make_shared<OpenGLTexture>(
-        pixels.data(),
-        width,
-        height,
-        4 // RGBA atlas
-    );
+    // Same font file at the same size rasterizes to the same atlas
+    CacheKey key;
+    if (m_cacheEnabled) {
+        // to_string() covers path, name and point size
+        key.identity = "font:" + glFont->to_string();
+        key.bytes = static_cast<std::size_t>(width) * height;
+        if (auto cached = findCached(key)) return cached;
+
+        key.content = hashPixels(pixels.data(), pixels.size(),
+                                 mix64(KindFont) ^ (static_cast<uint64_t>(width) << 32) ^ height);
+        key.width = width;
+        key.height = height;
+        key.channels = 1;
+        key.size = pixels.size();
+        key.pixels = std::shared_ptr<const std::vector<uint8_t>>(glFont, &pixels);
+        if (auto cached = findCached(key)) return cached;
+    }
+
+    // Coverage is stored as R8 and swizzled to white + alpha when sampled
+    std::shared_ptr<OpenGLTexture> texture;
+    if (OpenGLTexture::isSwizzleSupported()) {
+        graphics::TextureDesc desc;
+        desc.format = graphics::TextureFormat::Alpha8;
+        texture = std::make_shared<OpenGLTexture>(pixels.data(), width, height, 1, desc);
+    } else {
+        std::vector<uint8_t> rgba(pixels.size() * 4, 255);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+            rgba[i * 4 + 3] = pixels[i];
+        texture = std::make_shared<OpenGLTexture>(rgba.data(), width, height, 4);
+    }
+    track(texture);
+    if (m_cacheEnabled) storeCached(key, texture);
+    return texture;
 }
 
 } // namespace retronomicon::opengl::manager
@@ -0,0 +1,144 @@
+// Converts an image (PNG, TGA, JPG, ...) into block-compressed KTX2 files
+// loadable with OpenGLTextureManager::createCompressedTexture().
+//
+// Usage: ktx2_convert <input> <output-base> [--format bc1|bc3|bc7|etc2|etc2a|rgba8] [--all] [--mips]
+//
+//  --format  format to write (default bc7); writes <output-base>.<format>.ktx2
+//  --all     writes every block format, so the runtime can pick what the GPU supports
+//  --mips    stores a box-filtered mip chain down to 1x1
+
+#include "retronomicon/graphics/block_compression.h"
+#include "retronomicon/graphics/ktx2_file.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace retronomicon::opengl::graphics;
+
+namespace {
+
+// Halves an RGBA8 image, averaging 2x2 texels (edges clamp on odd sizes)
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& src, int width, int height) {
+    const int w = getMipSize(width, 1);
+    const int h = getMipSize(height, 1);
+    std::vector<uint8_t> dst(static_cast<std::size_t>(w) * h * 4);
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            const int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+            const int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+            for (int c = 0; c < 4; ++c) {
+                const int sum = src[(static_cast<std::size_t>(y0) * width + x0) * 4 + c]
+                              + src[(static_cast<std::size_t>(y0) * width + x1) * 4 + c]
+                              + src[(static_cast<std::size_t>(y1) * width + x0) * 4 + c]
+                              + src[(static_cast<std::size_t>(y1) * width + x1) * 4 + c];
+                dst[(static_cast<std::size_t>(y) * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    return dst;
+}
+
+void convert(const std::vector<std::vector<uint8_t>>& chain, int width, int height,
+             CompressedFormat format, const std::string& path) {
+    const auto start = std::chrono::steady_clock::now();
+
+    Ktx2Image image;
+    image.format = format;
+    image.width = width;
+    image.height = height;
+
+    std::size_t bytes = 0;
+    for (std::size_t level = 0; level < chain.size(); ++level) {
+        const int w = getMipSize(width, static_cast<int>(level));
+        const int h = getMipSize(height, static_cast<int>(level));
+
+        std::vector<uint8_t> data(getImageSize(format, w, h));
+        encodeImage(format, chain[level].data(), w, h, data.data());
+        bytes += data.size();
+        image.levels.push_back(std::move(data));
+    }
+
+    saveKtx2(path, image);
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-28s %6s  %zu level(s)  %9zu bytes  %8.1f ms\n",
+                path.c_str(), getFormatName(format), chain.size(), bytes, ms);
+}
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: ktx2_convert <input> <output-base> "
+                 "[--format bc1|bc3|bc7|etc2|etc2a|rgba8] [--all] [--mips]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+
+    const std::string input = argv[1];
+    const std::string base = argv[2];
+
+    std::vector<CompressedFormat> formats;
+    bool all = false, mips = false;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--all") == 0) {
+            all = true;
+        } else if (std::strcmp(argv[i], "--mips") == 0) {
+            mips = true;
+        } else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            CompressedFormat format;
+            if (!parseFormatName(argv[++i], format)) {
+                std::fprintf(stderr, "unknown format: %s\n", argv[i]);
+                return 1;
+            }
+            formats.push_back(format);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (all) {
+        formats = { CompressedFormat::BC1, CompressedFormat::BC3, CompressedFormat::BC7,
+                    CompressedFormat::ETC2_RGB, CompressedFormat::ETC2_RGBA };
+    } else if (formats.empty()) {
+        formats = { CompressedFormat::BC7 };
+    }
+
+    int width = 0, height = 0, channels = 0;
+    uint8_t* pixels = stbi_load(input.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::fprintf(stderr, "cannot load %s: %s\n", input.c_str(), stbi_failure_reason());
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t>> chain;
+    chain.emplace_back(pixels, pixels + static_cast<std::size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+
+    if (mips) {
+        for (int level = 0; getMipSize(width, level) > 1 || getMipSize(height, level) > 1; ++level)
+            chain.push_back(downsample(chain.back(), getMipSize(width, level), getMipSize(height, level)));
+    }
+
+    try {
+        for (CompressedFormat format : formats)
+            convert(chain, width, height, format, base + "." + getFormatName(format) + ".ktx2");
+    } catch (const std::runtime_error& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}